@@ -0,0 +1,110 @@
+#ifndef AnalysisDataFormats_TopObjects_interface_CATopJetFlatTagInfoCollection_h
+#define AnalysisDataFormats_TopObjects_interface_CATopJetFlatTagInfoCollection_h
+
+
+// \class CATopJetFlatTagInfoCollection
+//
+// \short flat, non-polymorphic companion of the CATopJetTagInfoCollection
+// CATopJetFlatTagInfoCollection holds the CATopJetProperties of all jets of
+// a jet collection as plain arrays, which are indexed parallel to the jet
+// collection. It keeps a single reference to the jet collection instead of
+// one RefToBase per jet and can be converted from and to the polymorphic
+// CATopJetTagInfoCollection without loss (up to the single precision of the
+// arrays). The pairwise subjet masses of all jets are kept in one array with
+// an offset per jet.
+//
+
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/Common/interface/RefToBaseProd.h"
+#include "AnalysisDataFormats/TopObjects/interface/CATopJetTagInfo.h"
+#include <vector>
+
+namespace reco {
+
+class CATopJetFlatTagInfoCollection {
+public:
+  typedef edm::RefToBaseProd<Jet> jets_type;
+
+  CATopJetFlatTagInfoCollection() {}
+  /// empty collection parallel to a given jet collection (no jet has a tag info yet)
+  CATopJetFlatTagInfoCollection(const edm::Handle<edm::View<Jet> >& jets);
+  /// collection parallel to a given jet collection filled from the tag infos of these jets
+  CATopJetFlatTagInfoCollection(const edm::Handle<edm::View<Jet> >& jets, const CATopJetTagInfoCollection& tagInfos);
+
+  /// number of jets
+  unsigned int size() const { return nSubJets_.size(); }
+  /// reference to the jet collection the arrays are parallel to
+  const jets_type& jets() const { return jets_; }
+
+  /// check whether jet 'i' has a tag info
+  bool hasTagInfo(unsigned int i) const { return nSubJets_[i] >= 0; }
+  /// number of subjets of jet 'i'; -1 if the jet has no tag info
+  int nSubJets(unsigned int i) const { return nSubJets_[i]; }
+  /// minimum invariant mass pairing of jet 'i'
+  float minMass(unsigned int i) const { return minMass_[i]; }
+  /// mass of jet 'i'
+  float topMass(unsigned int i) const { return topMass_[i]; }
+  /// mass of the pairing closest to the W mass of jet 'i'
+  float wMass(unsigned int i) const { return wMass_[i]; }
+  /// optional substructure observables of jet 'i' (see CATopJetProperties)
+  float wMassRatio    (unsigned int i) const { return wMassRatio_    [i]; }
+  float m23OverM123   (unsigned int i) const { return m23OverM123_   [i]; }
+  float atanM13OverM12(unsigned int i) const { return atanM13OverM12_[i]; }
+  float cosHelicity   (unsigned int i) const { return cosHelicity_   [i]; }
+  /// number of pairwise subjet masses of jet 'i' (0 if not computed)
+  unsigned int nPairMasses(unsigned int i) const { return pairMassOffsets_[i+1]-pairMassOffsets_[i]; }
+  /// pairwise subjet mass 'k' of jet 'i' (upper triangle row by row as in CATopJetProperties)
+  float pairMass(unsigned int i, unsigned int k) const { return pairMasses_[pairMassOffsets_[i]+k]; }
+  /// all properties of jet 'i' (promoted to double precision)
+  CATopJetProperties properties(unsigned int i) const;
+
+  /// arrays of all jets, indexed parallel to the jet collection
+  const std::vector<short>& nSubJets() const { return nSubJets_; }
+  const std::vector<float>& minMass () const { return minMass_;  }
+  const std::vector<float>& topMass () const { return topMass_;  }
+  const std::vector<float>& wMass   () const { return wMass_;    }
+  const std::vector<float>& wMassRatio    () const { return wMassRatio_;     }
+  const std::vector<float>& m23OverM123   () const { return m23OverM123_;    }
+  const std::vector<float>& atanM13OverM12() const { return atanM13OverM12_; }
+  const std::vector<float>& cosHelicity   () const { return cosHelicity_;    }
+  /// pairwise subjet masses of all jets; those of jet 'i' start at pairMassOffsets()[i]
+  /// and end at pairMassOffsets()[i+1]
+  const std::vector<float>&        pairMasses     () const { return pairMasses_;      }
+  const std::vector<unsigned int>& pairMassOffsets() const { return pairMassOffsets_; }
+
+  /// set the properties of jet 'i'
+  void set(unsigned int i, const CATopJetProperties& properties);
+  /// set the properties of the jets from a collection of tag infos of the same jet collection
+  void set(const CATopJetTagInfoCollection& tagInfos);
+  /// convert into polymorphic tag infos for all jets, which have a tag info; the
+  /// jet collection has to be the one the arrays are parallel to
+  void fillTagInfos(const edm::Handle<edm::View<Jet> >& jets, CATopJetTagInfoCollection& tagInfos) const;
+
+private:
+  /// resize all arrays to the given number of jets (jets without tag info)
+  void resize(unsigned int nJets);
+
+  /// reference to the jet collection
+  jets_type jets_;
+  /// number of subjets per jet (-1 for jets without tag info)
+  std::vector<short> nSubJets_;
+  /// minimum invariant mass pairing per jet
+  std::vector<float> minMass_;
+  /// jet mass per jet
+  std::vector<float> topMass_;
+  /// mass closest to the W mass per jet
+  std::vector<float> wMass_;
+  /// optional substructure observables per jet
+  std::vector<float> wMassRatio_;
+  std::vector<float> m23OverM123_;
+  std::vector<float> atanM13OverM12_;
+  std::vector<float> cosHelicity_;
+  /// pairwise subjet masses of all jets and the offsets of the jets (number of jets + 1)
+  std::vector<float> pairMasses_;
+  std::vector<unsigned int> pairMassOffsets_;
+};
+
+}
+
+#endif // AnalysisDataFormats_TopObjects_interface_CATopJetFlatTagInfoCollection_h
@@ -0,0 +1,86 @@
+#ifndef AnalysisDataFormats_TopObjects_interface_CATopJetSubstructure_h
+#define AnalysisDataFormats_TopObjects_interface_CATopJetSubstructure_h
+
+
+// \class CATopJetSubstructure
+//
+// \short batch computation of the CATopJetProperties for many jets at once
+// CATopJetSubjetBatch keeps the three leading subjets of a set of jets as a
+// structure of arrays; CATopJetSubstructure computes the CATopJetProperties
+// of all jets in the batch with a branch-free pairwise invariant mass scan
+// that the compiler can vectorize over jets. The optional substructure
+// observables of the CATopJetProperties are filled per jet.
+//
+
+#include "DataFormats/JetReco/interface/Jet.h"
+#include "DataFormats/Math/interface/LorentzVector.h"
+#include "AnalysisDataFormats/TopObjects/interface/CATopJetTagInfo.h"
+#include <vector>
+
+namespace reco {
+
+class CATopJetSubjetBatch {
+public:
+  /// number of leading subjets (in pt) that enter the pairwise mass scan
+  static const unsigned int nLeadingSubJets = 3;
+
+  CATopJetSubjetBatch() {}
+
+  /// add a jet from its subjet four-vectors; the jet mass is taken from the sum of the subjets
+  unsigned int addJet(const std::vector<math::XYZTLorentzVector>& subjets);
+  /// add a jet from its subjet four-vectors and the mass of the (fat) jet
+  unsigned int addJet(const std::vector<math::XYZTLorentzVector>& subjets, double jetMass);
+  /// add a jet, whose daughters are the subjets
+  unsigned int addJet(const Jet& jet);
+  /// reserve memory for a given number of jets
+  void reserve(unsigned int nJets);
+  /// remove all jets, but keep the allocated memory
+  void clear();
+  /// number of jets in the batch
+  unsigned int size() const { return nSubJets_.size(); }
+
+  /// number of subjets of jet 'i'
+  int nSubJets(unsigned int i) const { return nSubJets_[i]; }
+  /// mass of jet 'i'
+  double jetMass(unsigned int i) const { return jetMass_[i]; }
+
+private:
+  friend class CATopJetSubstructure;
+
+  /// components of the leading subjets, one array per subjet rank and
+  /// component, indexed by jet (zero for missing subjets)
+  std::vector<double> px_[nLeadingSubJets], py_[nLeadingSubJets], pz_[nLeadingSubJets], e_[nLeadingSubJets];
+  /// number of subjets per jet
+  std::vector<int>    nSubJets_;
+  /// mass of the jet
+  std::vector<double> jetMass_;
+};
+
+class CATopJetSubstructure {
+public:
+  /// default value of the W mass used for the closest-to-W pairing
+  CATopJetSubstructure(double wMass=80.4) : wMass_(wMass) {}
+
+  /// compute the properties of all jets in the batch; 'properties' is
+  /// resized to the size of the batch and filled parallel to it
+  void compute(const CATopJetSubjetBatch& batch, std::vector<CATopJetProperties>& properties) const;
+  /// compute minMass and wMass of all jets in the batch into plain arrays parallel to the batch
+  void compute(const CATopJetSubjetBatch& batch, std::vector<double>& minMass, std::vector<double>& wMass) const;
+  /// fill the optional substructure observables (pairwise subjet mass matrix, mass ratios
+  /// and helicity angle) of 'properties' from the subjet four-vectors of the same jet;
+  /// meant to be called once when the tag info is produced
+  void computeObservables(const std::vector<math::XYZTLorentzVector>& subjets, CATopJetProperties& properties) const;
+
+  /// value of minMass for jets with less than three subjets
+  static const double noMinMass;
+  /// value of wMass for jets with less than three subjets
+  static const double noWMass;
+
+private:
+  /// W mass used for the closest-to-W pairing
+  double wMass_;
+};
+
+}
+
+#endif // AnalysisDataFormats_TopObjects_interface_CATopJetSubstructure_h
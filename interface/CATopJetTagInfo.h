@@ -26,11 +26,32 @@ public:
     minMass = 0.;
     topMass = 0.;
     wMass = 0.;
+    wMassRatio = -1.;
+    m23OverM123 = -1.;
+    atanM13OverM12 = -1.;
+    cosHelicity = -2.;
   }
+  /// check whether the substructure observables below were computed; this needs at least
+  /// two subjets, the observables of the three leading subjets stay at their defaults for
+  /// jets with less than three subjets
+  bool hasObservables() const { return !pairMasses.empty(); }
+  /// pairwise invariant mass of subjets i and j (ordered in pt); -1 if not available
+  double pairMass(unsigned int i, unsigned int j) const {
+    if(i == j || i >= (unsigned int)nSubJets || j >= (unsigned int)nSubJets) return -1.;
+    if(i > j) { unsigned int k = i; i = j; j = k; }
+    unsigned int idx = i*(2*nSubJets-i-1)/2 + (j-i-1);
+    return idx < pairMasses.size() ? pairMasses[idx] : -1.;
+  }
+
   int                 nSubJets;        //<! Number of subjets
   double              minMass;         //<! Minimum invariant mass pairing
   double              topMass;         //<! Jet mass
   double              wMass;           //<! Closest mass to W mass
+  std::vector<double> pairMasses;      //<! Pairwise subjet masses, upper triangle row by row (subjets ordered in pt); optional
+  double              wMassRatio;      //<! mass of the subjet pairing closest to the W mass over the mass of all subjets; optional
+  double              m23OverM123;     //<! m23/m123 of the three leading subjets; optional
+  double              atanM13OverM12;  //<! atan(m13/m12) of the three leading subjets; optional
+  double              cosHelicity;     //<! cosine of the W helicity angle; optional
 };
 
  class CATopJetTagInfo : public JetTagInfo {
@@ -6,6 +6,7 @@
 #define TopObjects_StEvtSolution_h
 
 #include <vector>
+#include <string>
 
 #include "DataFormats/Common/interface/Handle.h"
 #include "DataFormats/Common/interface/RefProd.h"
@@ -18,6 +19,8 @@
 #include "DataFormats/PatCandidates/interface/MET.h"
 
 #include "AnalysisDataFormats/TopObjects/interface/StGenEvent.h"
+#include "AnalysisDataFormats/TopObjects/interface/TopRefProdCache.h"
+#include "AnalysisDataFormats/TopObjects/interface/TopScanCurve.h"
 
 class StEvtSolution {
 
@@ -75,12 +78,28 @@ class StEvtSolution {
   //-------------------------------------------
   // get info on the selected decay
   //-------------------------------------------
-  std::string getDecay() const { return decay_; }
+  std::string getDecay() const { return WDecay::leptonName(lepType_); }
+  WDecay::LeptonType getLeptonType() const { return lepType_; }
+
+  //-------------------------------------------
+  // get four-vectors of the composites without 
+  // copying pat::Jets or creating reco::Particles
+  //-------------------------------------------
+  enum P4Level { kRec, kCal, kFit };
+  struct CompositeP4 {
+    math::XYZTLorentzVector lept, lepW;
+  };
+  math::XYZTLorentzVector getLeptP4(P4Level level) const;
+  math::XYZTLorentzVector getLepWP4(P4Level level) const;
+  // all composites in one call
+  void getCompositeP4(CompositeP4& p4, P4Level level) const;
 
   //-------------------------------------------
   // get other event info
   //-------------------------------------------
-  std::vector<double> getScanValues() const { return scanValues_; }
+  /// scanned values; empty if only the peak of the scan is stored
+  std::vector<double> getScanValues() const { return scanCurve_.hasValues() ? scanCurve_.values() : std::vector<double>(); }
+  const TopScanCurve& getScanCurve() const { return scanCurve_; }
   double getChi2Prob()       const { return chi2Prob_; }
   double getPtrueCombExist() const { return pTrueCombExist_; }
   double getPtrueBJetSel()  const { return pTrueBJetSel_; }
@@ -110,9 +129,9 @@ class StEvtSolution {
   void setLight (const edm::Handle<std::vector<pat::Jet > >& jet, int i) 
   { light_ = edm::Ref<std::vector<pat::Jet> >(jet, i); };
   void setMuon  (const edm::Handle<std::vector<pat::Muon> >& muon, int i) 
-  { muon_ = edm::Ref<std::vector<pat::Muon> >(muon, i); decay_ = "muon"; };
+  { muon_ = edm::Ref<std::vector<pat::Muon> >(muon, i); lepType_ = WDecay::kMuon; };
   void setElectron(const edm::Handle<std::vector<pat::Electron> >& elec, int i) 
-  { electron_ = edm::Ref<std::vector<pat::Electron> >(elec, i); decay_ = "electron"; };
+  { electron_ = edm::Ref<std::vector<pat::Electron> >(elec, i); lepType_ = WDecay::kElec; };
   void setNeutrino(const edm::Handle<std::vector<pat::MET> >& met, int i)
   { neutrino_ = edm::Ref<std::vector<pat::MET> >(met, i); };
 
@@ -128,7 +147,11 @@ class StEvtSolution {
   // set other info on the event
   //-------------------------------------------
   void setChi2Prob(double prob){ chi2Prob_ = prob; };
+  /// replace the scanned values (on the grid points 0, 1, ...)
   void setScanValues(const std::vector<double>&);
+  /// replace the scanned values on the grid points start+i*step
+  void setScanCurve(double start, double step, const std::vector<double>& val, TopScanCurve::Storage storage=TopScanCurve::kFloat)
+  { scanCurve_.set(start, step, val, storage); };
   void setPtrueCombExist(double pce){ pTrueCombExist_ = pce; };
   void setPtrueBJetSel (double pbs) { pTrueBJetSel_   = pbs; };
   void setPtrueBhadrSel(double pbh) { pTrueBhadrSel_  = pbh; };
@@ -143,10 +166,19 @@ class StEvtSolution {
   
  private:
 
+  //-------------------------------------------
+  // four-vector of the b jet on a given level
+  //-------------------------------------------
+  math::XYZTLorentzVector getBottomP4(P4Level level) const;
+  math::XYZTLorentzVector getFitP4(const std::vector<pat::Particle>& fit) const
+  { return fit.empty() ? math::XYZTLorentzVector() : math::XYZTLorentzVector(fit.front().p4()); };
+
   //-------------------------------------------  
   // particle content
   //-------------------------------------------
   edm::RefProd<StGenEvent> theGenEvt_;
+  /// resolved product of theGenEvt_ (transient)
+  TopRefProdCache<StGenEvent> theGenEvtCache_;
   edm::Ref<std::vector<pat::Jet> >  bottom_, light_;
   edm::Ref<std::vector<pat::Muon> > muon_;
   edm::Ref<std::vector<pat::Electron> > electron_;
@@ -156,10 +188,10 @@ class StEvtSolution {
   //-------------------------------------------
   // miscellaneous
   //-------------------------------------------
-  std::string decay_;
+  WDecay::LeptonType lepType_;
   int jetCorrScheme_;
   double chi2Prob_;
-  std::vector<double> scanValues_;
+  TopScanCurve scanCurve_;
   double pTrueCombExist_, pTrueBJetSel_, pTrueBhadrSel_, pTrueJetComb_;
   double signalPur_, signalLRTot_;
   double sumDeltaRjp_, deltaRB_, deltaRL_;
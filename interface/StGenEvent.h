@@ -2,6 +2,7 @@
 #define TopObjects_StGenEvent_h
 
 #include "AnalysisDataFormats/TopObjects/interface/TopGenEvent.h"
+#include "AnalysisDataFormats/TopObjects/interface/TopCacheFlag.h"
 
 /**
    \class   StGenEvent StGenEvent.h "AnalysisDataFormats/TopObjects/interface/StGenEvent.h"
@@ -36,6 +37,21 @@ class StGenEvent: public TopGenEvent {
   const reco::GenParticle* decayB() const;
   /// return associated b 
   const reco::GenParticle* associatedB() const;
+
+ private:
+
+  /// single-top roles as cached in roles_
+  enum Role { kLepton, kNeutrino, kW, kTop, kDecayB, kAssociatedB, kNumberOfRoles };
+
+  /// return the cached candidate of a given role; the roles are resolved on first use
+  const reco::GenParticle* role(Role r) const;
+  /// resolve all single-top roles in a single pass over the decay chain
+  void resolveRoles(const reco::GenParticle* roles[kNumberOfRoles]) const;
+
+  /// transient cache of the resolved roles (not persistent)
+  mutable const reco::GenParticle* roles_[kNumberOfRoles];
+  /// transient state of roles_ (not persistent)
+  TopCacheFlag rolesFlag_;
 };
 
 #endif
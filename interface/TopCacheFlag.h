@@ -0,0 +1,44 @@
+#ifndef TopObjects_TopCacheFlag_h
+#define TopObjects_TopCacheFlag_h
+
+/**
+   \class   TopCacheFlag TopCacheFlag.h "AnalysisDataFormats/TopObjects/interface/TopCacheFlag.h"
+
+   \brief   State of a transient cache that is filled on first use and read concurrently
+
+   The cache is filled only by the thread that wins lock(); all other threads see it as
+   filled only after the filling thread called setFilled(), with the memory barriers of
+   the atomic builtins making the cached values visible. Threads that lose the race are
+   expected to compute their own (identical) result instead of waiting. Copies start
+   from an empty cache. reset() must not be called concurrently with any other method.
+
+   Usage:
+
+     if(!flag_.isFilled() && flag_.lock()) { fill cache_; flag_.setFilled(); }
+     if(flag_.isFilled()) return cache_; else compute without caching
+*/
+
+class TopCacheFlag {
+
+ public:
+  /// empty cache
+  TopCacheFlag() : state_(kEmpty) {};
+  /// copies start from an empty cache
+  TopCacheFlag(const TopCacheFlag&) : state_(kEmpty) {};
+  TopCacheFlag& operator=(const TopCacheFlag&) { state_ = kEmpty; return *this; };
+
+  /// check if the cache was filled
+  bool isFilled() const { const int state = state_; __sync_synchronize(); return state==kFilled; };
+  /// try to get the right to fill the cache; true for exactly one caller
+  bool lock() const { return __sync_bool_compare_and_swap(&state_, (int)kEmpty, (int)kFilling); };
+  /// publish the filled cache (to be called by the thread that got the lock)
+  void setFilled() const { __sync_synchronize(); state_ = kFilled; };
+  /// mark the cache as empty again
+  void reset() { state_ = kEmpty; };
+
+ private:
+  enum State { kEmpty, kFilling, kFilled };
+  mutable volatile int state_;
+};
+
+#endif
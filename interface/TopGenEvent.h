@@ -1,8 +1,12 @@
 #ifndef TopObjects_TopGenEvent_h
 #define TopObjects_TopGenEvent_h
 
+#include <string>
+
 #include "DataFormats/Candidate/interface/Candidate.h"
 #include "DataFormats/HepMCCandidate/interface/GenParticle.h"
+#include "AnalysisDataFormats/TopObjects/interface/TopRefProdCache.h"
+#include "AnalysisDataFormats/TopObjects/interface/TopRadiationIndex.h"
 
 
 namespace TopDecayID{
@@ -26,6 +30,11 @@ namespace WDecay{
   /// of the W boson used in several places throughout 
   /// the package
   enum LeptonType {kNone, kElec, kMuon, kTau};
+  /// lower case name of the lepton type as used by the legacy
+  /// event solutions ("electron", "muon", "tau"; "" for kNone)
+  const char* leptonName(LeptonType type);
+  /// lepton type from its lower case name (kNone if unknown)
+  LeptonType leptonType(const std::string& name);
 }
 
 /**
@@ -50,11 +59,16 @@ class TopGenEvent {
   virtual ~TopGenEvent(){};
 
   /// return particles of decay chain
-  const reco::GenParticleCollection& particles() const { return *parts_; }
+  const reco::GenParticleCollection& particles() const { return partsCache_(parts_); }
   /// return particles of initial partons
-  const reco::GenParticleCollection& initialPartons() const { return *initPartons_;}
+  const reco::GenParticleCollection& initialPartons() const { return initPartonsCache_(initPartons_);}
   /// return radiated gluons from particle with pdgId
   std::vector<const reco::GenParticle*> radiatedGluons(int pdgId) const;
+  /// return gluons and/or photons (see TopRadiationIndex::Type) radiated by 'emitter', e.g. the
+  /// top, W or b of a decay branch; with 'recursive' the radiation of radiated particles is
+  /// included; the returned particles are part of the decay chain and not copied; the index
+  /// is built on first use and cached, safe for concurrent use
+  std::vector<const reco::GenParticle*> radiation(const reco::Candidate* emitter, const int type=TopRadiationIndex::kGluonOrPhoton, const bool recursive=false) const;
   /// return all light quarks or all quarks including b's 
   std::vector<const reco::GenParticle*> lightQuarks(bool includingBQuarks=false) const;
   /// return number of leptons in the decay chain
@@ -115,6 +129,16 @@ class TopGenEvent {
   reco::GenParticleRefProd parts_;       
   /// reference to the list of initial partons (has to be kept in the event!)
   reco::GenParticleRefProd initPartons_; 
+  /// resolved products of parts_ and initPartons_ (transient)
+  TopRefProdCache<reco::GenParticleCollection> partsCache_;
+  TopRefProdCache<reco::GenParticleCollection> initPartonsCache_;
+
+ private:
+
+  /// transient index of the radiation in the decay chain (not persistent)
+  mutable TopRadiationIndex radiationIndex_;
+  /// transient state of radiationIndex_ (not persistent)
+  TopCacheFlag radiationIndexFlag_;
 };
 
 #endif
@@ -0,0 +1,63 @@
+#ifndef TopObjects_TopRadiationIndex_h
+#define TopObjects_TopRadiationIndex_h
+
+#include <vector>
+
+#include "DataFormats/HepMCCandidate/interface/GenParticle.h"
+
+/**
+   \class   TopRadiationIndex TopRadiationIndex.h "AnalysisDataFormats/TopObjects/interface/TopRadiationIndex.h"
+
+   \brief   Index of the gluons and photons radiated by the particles of a top decay chain
+
+   The index is built in a single pass over the decay subset. For each particle of the
+   collection it keeps the positions of the gluons and photons whose mother it is, gluons
+   first, one particle after the other in a single vector. The radiation of a top, W or
+   b quark is then found without scanning the collection again. The index is only valid
+   for the collection it was built from.
+*/
+
+class TopRadiationIndex {
+
+ public:
+  /// kind of radiation
+  enum Type { kGluon=1, kPhoton=2, kGluonOrPhoton=3 };
+
+  /// empty index
+  TopRadiationIndex() {};
+  /// index for the particles of 'parts'
+  explicit TopRadiationIndex(const reco::GenParticleCollection& parts) { build(parts); };
+
+  /// build the index for the particles of 'parts'
+  void build(const reco::GenParticleCollection& parts);
+  /// remove all entries
+  void clear() { ends_.clear(); gluonEnds_.clear(); radiation_.clear(); };
+
+  /// number of particles in the indexed collection
+  unsigned int size() const { return ends_.size(); };
+  /// position of 'particle' in 'parts'; -1 if it is not part of the collection
+  static int position(const reco::GenParticleCollection& parts, const reco::Candidate* particle);
+
+  /// positions of the gluons and photons radiated by the particle at position 'i', gluons first
+  const unsigned int* begin(const unsigned int i) const { return radiation_.empty() ? 0 : &radiation_[0]+(i==0 ? 0 : ends_[i-1]); };
+  const unsigned int* end(const unsigned int i) const { return radiation_.empty() ? 0 : &radiation_[0]+ends_[i]; };
+  /// number of gluons radiated by the particle at position 'i'
+  unsigned int numberOfGluons(const unsigned int i) const { return gluonEnds_[i]-(i==0 ? 0 : ends_[i-1]); };
+  /// number of photons radiated by the particle at position 'i'
+  unsigned int numberOfPhotons(const unsigned int i) const { return ends_[i]-gluonEnds_[i]; };
+
+  /// append the particles of kind 'type' radiated by the particle at position 'i' to
+  /// 'result'; with 'recursive' the radiation of the radiated particles is followed
+  void radiation(const reco::GenParticleCollection& parts, const unsigned int i, std::vector<const reco::GenParticle*>& result,
+		 const int type=kGluonOrPhoton, const bool recursive=false) const;
+
+ private:
+  /// end of the radiation of each particle in radiation_
+  std::vector<unsigned int> ends_;
+  /// end of the gluons of each particle in radiation_
+  std::vector<unsigned int> gluonEnds_;
+  /// positions of the radiated particles, one particle after the other
+  std::vector<unsigned int> radiation_;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef TopObjects_TopRefProdCache_h
+#define TopObjects_TopRefProdCache_h
+
+#include "DataFormats/Common/interface/RefProd.h"
+#include "AnalysisDataFormats/TopObjects/interface/TopCacheFlag.h"
+
+/**
+   \class   TopRefProdCache TopRefProdCache.h "AnalysisDataFormats/TopObjects/interface/TopRefProdCache.h"
+
+   \brief   Transient cache of the product an edm::RefProd points to
+
+   Keeps the pointer to the product once the edm::RefProd has been resolved, so that
+   repeated accesses do not go through the product getter again. The cache is filled
+   on first use and safe for concurrent reads (see TopCacheFlag); it has to be reset
+   whenever the edm::RefProd is changed. Copies start from an empty cache.
+
+   Usage:
+
+     const reco::GenParticleCollection& particles() const { return partsCache_(parts_); }
+*/
+
+template <typename T>
+class TopRefProdCache {
+
+ public:
+  /// empty cache
+  TopRefProdCache() : product_(0) {};
+
+  /// return the product of 'ref'; 0 if the reference is null
+  const T* get(const edm::RefProd<T>& ref) const
+  {
+    if( ref.isNull() )
+      return 0;
+    if( !flag_.isFilled() && flag_.lock() ){
+      product_ = ref.get();
+      flag_.setFilled();
+    }
+    return flag_.isFilled() ? product_ : ref.get();
+  };
+  /// return the product of 'ref'; throws like edm::RefProd if the reference is null
+  const T& operator()(const edm::RefProd<T>& ref) const { const T* product = get(ref); return product ? *product : *ref; };
+  /// clear the cache
+  void reset() { flag_.reset(); product_ = 0; };
+
+ private:
+  /// cached product
+  mutable const T* product_;
+  /// state of the cache
+  TopCacheFlag flag_;
+};
+
+#endif
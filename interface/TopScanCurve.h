@@ -0,0 +1,83 @@
+#ifndef TopObjects_TopScanCurve_h
+#define TopObjects_TopScanCurve_h
+
+#include <vector>
+
+/**
+   \class   TopScanCurve TopScanCurve.h "AnalysisDataFormats/TopObjects/interface/TopScanCurve.h"
+
+   \brief   Compact storage of a curve scanned on a fixed grid
+
+   The curve is given by its values on the grid points x_i = start+i*step for i=0..size()-1.
+   The grid itself is stored by start, step and number of points only. The values are kept
+   either
+
+    - kFloat     : in single precision
+    - kQuantized : as 16 bit integers on a linear scale between the smallest and the largest
+                   value (the precision is (max-min)/65535)
+    - kPeakOnly  : not at all; only the position and value of the maximum are kept
+
+   Position and value of the maximum are available for all storage modes.
+*/
+
+class TopScanCurve {
+
+ public:
+  /// supported storage modes of the values
+  enum Storage { kFloat, kQuantized, kPeakOnly };
+
+ public:
+  /// empty constructor
+  TopScanCurve() : start_(0.), step_(1.), size_(0), storage_(kFloat), offset_(0.), scale_(0.), peakIndex_(-1), peakValue_(0.) {};
+  /// curve with 'values' on the grid points start+i*step
+  TopScanCurve(const double start, const double step, const std::vector<double>& values, const Storage storage=kFloat);
+  /// default destructor
+  ~TopScanCurve(){};
+
+  /// replace the curve by 'values' on the grid points start+i*step
+  void set(const double start, const double step, const std::vector<double>& values, const Storage storage=kFloat);
+  /// remove all values
+  void clear();
+
+  /// number of grid points
+  unsigned int size() const { return size_; };
+  /// check if there are no grid points
+  bool empty() const { return size_==0; };
+  /// first grid point and distance of the grid points
+  double start() const { return start_; };
+  double step() const { return step_; };
+  /// grid point i
+  double x(const unsigned int i) const { return start_+i*step_; };
+  /// storage mode of the values
+  Storage storage() const { return (Storage)storage_; };
+  /// check if the values are stored (i.e. the storage mode is not kPeakOnly)
+  bool hasValues() const { return storage_!=kPeakOnly; };
+  /// value at grid point i; throws if the values are not stored
+  double value(const unsigned int i) const;
+  /// values at all grid points; throws if the values are not stored
+  std::vector<double> values() const;
+
+  /// index, grid point and value of the maximum; index -1, grid point and value 0 for an empty curve
+  int peakIndex() const { return peakIndex_; };
+  double peakX() const { return peakIndex_<0 ? 0. : x(peakIndex_); };
+  double peakValue() const { return peakValue_; };
+
+ private:
+  /// grid
+  double start_;
+  double step_;
+  unsigned int size_;
+  /// storage mode
+  unsigned char storage_;
+  /// values for the storage mode kFloat
+  std::vector<float> values_;
+  /// values for the storage mode kQuantized: value = offset_+scale_*quantized_
+  std::vector<unsigned short> quantized_;
+  double offset_;
+  double scale_;
+  /// maximum
+  int peakIndex_;
+  double peakValue_;
+};
+
+#endif
@@ -0,0 +1,256 @@
+#ifndef TopObjects_TtColumnFile_h
+#define TopObjects_TtColumnFile_h
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <stdint.h>
+
+/**
+   \namespace TtColumnFile TtColumnFile.h "AnalysisDataFormats/TopObjects/interface/TtColumnFile.h"
+
+   \brief   Layout of the binary column files written by the TtEventFlattener and read by the TtColumnReader
+
+   Every column is kept in a file of its own, which consists of a fixed size Header
+   followed by the values of the column as a plain array in the native byte order.
+   The header is 64 bytes long, such that the values are aligned for all supported
+   types and the file can be memory mapped and used as an array directly.
+*/
+
+namespace TtColumnFile {
+  /// identifier at the beginning of every column file
+  static const char magic[8] = {'T','T','C','O','L','U','M','N'};
+  /// version of the file layout
+  static const uint32_t version = 1;
+  /// file name extension of column files
+  static const std::string extension = ".col";
+  /// type of the values of a column
+  enum ValueType { kInt32=1, kFloat32=2, kFloat64=3 };
+  /// size in bytes of a value of the given type
+  inline unsigned int valueSize(const ValueType type) { return type==kFloat64 ? 8 : 4; };
+  /// fixed size header at the beginning of every column file
+  struct Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t type;
+    uint64_t entries;
+    char     padding[40];
+  };
+  /// separator of role paths in column names (e.g. "HadTop/HadW.mass") and the
+  /// character it is replaced with in the names of the column files
+  static const char pathSeparator = '/';
+  static const char fileSeparator = ':';
+  /// name of the file of a column (without directory and extension)
+  inline std::string fileName(std::string column) {
+    std::replace(column.begin(), column.end(), pathSeparator, fileSeparator);
+    return column;
+  };
+  /// name of the column kept in a file (without directory and extension)
+  inline std::string columnName(std::string file) {
+    std::replace(file.begin(), file.end(), fileSeparator, pathSeparator);
+    return file;
+  };
+}
+
+/**
+   \class   TtColumnSink TtColumnFile.h "AnalysisDataFormats/TopObjects/interface/TtColumnFile.h"
+
+   \brief   Destination of the values of a single column
+*/
+
+class TtColumnSink {
+
+ public:
+  /// default destructor
+  virtual ~TtColumnSink(){};
+
+  /// append a value (converted to the type of the column)
+  virtual void fill(const double value) = 0;
+};
+
+/**
+   \class   TtColumnWriter TtColumnFile.h "AnalysisDataFormats/TopObjects/interface/TtColumnFile.h"
+
+   \brief   Buffered writer of a single column file
+
+   Values are collected in a memory buffer and written to the file in blocks. The
+   number of entries in the header is only final after close(), which is called
+   by the destructor as well.
+*/
+
+class TtColumnWriter : public TtColumnSink {
+
+ public:
+  /// open 'fileName' for a column of the given type, 'bufferSize' is given in values
+  TtColumnWriter(const std::string& fileName, const TtColumnFile::ValueType type, const unsigned int bufferSize=8192);
+  /// default destructor; closes the file
+  virtual ~TtColumnWriter();
+
+  /// append a value (converted to the type of the column)
+  virtual void fill(const double value);
+  /// write all buffered values and the final header and close the file
+  void close();
+  /// number of values filled so far
+  uint64_t entries() const { return entries_; };
+  /// name of the file
+  const std::string& fileName() const { return fileName_; };
+
+ private:
+  /// not copyable
+  TtColumnWriter(const TtColumnWriter&);
+  TtColumnWriter& operator=(const TtColumnWriter&);
+
+  /// write the buffered values to the file
+  void flush();
+  /// write the header with the current number of entries
+  void writeHeader();
+
+  std::string fileName_;
+  std::FILE* file_;
+  TtColumnFile::ValueType type_;
+  /// buffered values (as raw bytes) and number of bytes in use
+  std::vector<char> buffer_;
+  unsigned int used_;
+  uint64_t entries_;
+};
+
+/**
+   \class   TtColumnBuffer TtColumnFile.h "AnalysisDataFormats/TopObjects/interface/TtColumnFile.h"
+
+   \brief   Column kept in memory as a contiguous array
+
+   Only the vector of the type of the column is filled; the values can be handed on
+   without copying (e.g. to numpy via the buffer protocol of std::vector in PyROOT).
+*/
+
+class TtColumnBuffer : public TtColumnSink {
+
+ public:
+  /// empty column of the given type
+  explicit TtColumnBuffer(const TtColumnFile::ValueType type) : type_(type) {};
+  /// default destructor
+  virtual ~TtColumnBuffer(){};
+
+  /// append a value (converted to the type of the column)
+  virtual void fill(const double value);
+  /// type of the values
+  TtColumnFile::ValueType type() const { return type_; };
+  /// number of values
+  unsigned int size() const;
+  /// values of columns of type kInt32, kFloat32 and kFloat64
+  const std::vector<int32_t>& ints() const { return ints_; };
+  const std::vector<float>& floats() const { return floats_; };
+  const std::vector<double>& doubles() const { return doubles_; };
+  /// address of the first value; 0 if empty
+  const void* data() const;
+  /// reserve memory for 'n' values
+  void reserve(const unsigned int n);
+  /// remove all values, keeping the allocated memory
+  void clear() { ints_.clear(); floats_.clear(); doubles_.clear(); };
+
+ private:
+  TtColumnFile::ValueType type_;
+  std::vector<int32_t> ints_;
+  std::vector<float> floats_;
+  std::vector<double> doubles_;
+};
+
+/**
+   \class   TtColumnView TtColumnFile.h "AnalysisDataFormats/TopObjects/interface/TtColumnFile.h"
+
+   \brief   Non-owning view on a contiguous range of column values
+
+   The view points into memory owned by a TtColumnReader and is only valid as long
+   as the reader is.
+*/
+
+template <typename T>
+class TtColumnView {
+
+ public:
+  typedef const T* const_iterator;
+
+  /// empty view
+  TtColumnView() : begin_(0), end_(0) {};
+  /// view on the range [begin, end)
+  TtColumnView(const T* begin, const T* end) : begin_(begin), end_(end) {};
+
+  /// number of values
+  unsigned int size() const { return end_-begin_; };
+  /// check if there are no values
+  bool empty() const { return begin_==end_; };
+  /// value at index i
+  const T& operator[](const unsigned int i) const { return begin_[i]; };
+  /// begin and end of the range
+  const_iterator begin() const { return begin_; };
+  const_iterator end() const { return end_; };
+  /// values [first, first+n) as view
+  TtColumnView<T> range(const unsigned int first, const unsigned int n) const { return TtColumnView<T>(begin_+first, begin_+first+n); };
+
+ private:
+  const T* begin_;
+  const T* end_;
+};
+
+/**
+   \class   TtColumnReader TtColumnFile.h "AnalysisDataFormats/TopObjects/interface/TtColumnFile.h"
+
+   \brief   Read-only memory mapped column file
+
+   The file is mapped into memory as a whole on construction and the values are
+   accessed in place. The header is checked for the magic, the layout version and
+   for a file size consistent with the number of entries.
+*/
+
+class TtColumnReader {
+
+ public:
+  /// map 'fileName' into memory
+  explicit TtColumnReader(const std::string& fileName);
+  /// default destructor; unmaps the file
+  ~TtColumnReader();
+
+  /// type of the values
+  TtColumnFile::ValueType type() const { return type_; };
+  /// number of values
+  uint64_t entries() const { return entries_; };
+  /// name of the file
+  const std::string& fileName() const { return fileName_; };
+  /// view on the values; T has to match the type of the column
+  template <typename T> TtColumnView<T> view() const;
+
+ private:
+  /// not copyable
+  TtColumnReader(const TtColumnReader&);
+  TtColumnReader& operator=(const TtColumnReader&);
+
+  /// check that the values are of the size of T
+  void checkType(const TtColumnFile::ValueType type) const;
+
+  std::string fileName_;
+  /// mapped memory and its size in bytes
+  void* data_;
+  size_t size_;
+  TtColumnFile::ValueType type_;
+  uint64_t entries_;
+};
+
+namespace TtColumnFile {
+  /// value type of a C++ type
+  template <typename T> ValueType valueType();
+  template <> inline ValueType valueType<int32_t>() { return kInt32;   };
+  template <> inline ValueType valueType<float  >() { return kFloat32; };
+  template <> inline ValueType valueType<double >() { return kFloat64; };
+}
+
+template <typename T>
+TtColumnView<T>
+TtColumnReader::view() const
+{
+  checkType(TtColumnFile::valueType<T>());
+  const T* begin = (const T*)((const char*)data_+sizeof(TtColumnFile::Header));
+  return TtColumnView<T>(begin, begin+entries_);
+}
+
+#endif
@@ -15,6 +15,7 @@
 #include "DataFormats/Candidate/interface/Particle.h"
 #include "DataFormats/HepMCCandidate/interface/GenParticle.h"
 #include "AnalysisDataFormats/TopObjects/interface/TtGenEvent.h"
+#include "AnalysisDataFormats/TopObjects/interface/TopRefProdCache.h"
 
 #include "DataFormats/PatCandidates/interface/Particle.h"
 #include "DataFormats/PatCandidates/interface/Electron.h"
@@ -27,6 +28,7 @@ class TtDilepEvtSolution {
   
   friend class TtFullLepKinSolver;
   friend class TtDilepEvtSolutionMaker;
+  friend class TtFullLepKinSolutionScan;
   friend class TtDilepLRSignalSelObservables;
   friend class TtLRSignalSelCalc;
   
@@ -52,16 +54,16 @@ class TtDilepEvtSolution {
   // get the matched gen particles
   //-------------------------------------------
   const edm::RefProd<TtGenEvent> & getGenEvent() const { return theGenEvt_; };
-  const reco::GenParticle * getGenT() const { if (!theGenEvt_) return 0; else return theGenEvt_->top(); };
-  const reco::GenParticle * getGenWp() const { if (!theGenEvt_) return 0; else return theGenEvt_->wPlus(); };
-  const reco::GenParticle * getGenB() const { if (!theGenEvt_) return 0; else return theGenEvt_->b(); };
-  const reco::GenParticle * getGenLepp() const { if (!theGenEvt_) return 0; else return theGenEvt_->leptonBar(); };
-  const reco::GenParticle * getGenN() const { if (!theGenEvt_) return 0; else return theGenEvt_->neutrino(); };
-  const reco::GenParticle * getGenTbar() const { if (!theGenEvt_) return 0; else return theGenEvt_->topBar(); };
-  const reco::GenParticle * getGenWm() const { if (!theGenEvt_) return 0; else return theGenEvt_->wMinus(); };
-  const reco::GenParticle * getGenBbar() const { if (!theGenEvt_) return 0; else return theGenEvt_->bBar(); };
-  const reco::GenParticle * getGenLepm() const { if (!theGenEvt_) return 0; else return theGenEvt_->lepton(); };
-  const reco::GenParticle * getGenNbar() const { if (!theGenEvt_) return 0; else return theGenEvt_->neutrinoBar(); };
+  const reco::GenParticle * getGenT() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->top(); };
+  const reco::GenParticle * getGenWp() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->wPlus(); };
+  const reco::GenParticle * getGenB() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->b(); };
+  const reco::GenParticle * getGenLepp() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->leptonBar(); };
+  const reco::GenParticle * getGenN() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->neutrino(); };
+  const reco::GenParticle * getGenTbar() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->topBar(); };
+  const reco::GenParticle * getGenWm() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->wMinus(); };
+  const reco::GenParticle * getGenBbar() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->bBar(); };
+  const reco::GenParticle * getGenLepm() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->lepton(); };
+  const reco::GenParticle * getGenNbar() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->neutrinoBar(); };
 
   //-------------------------------------------
   // get (un-)/calibrated reco objects
@@ -74,8 +76,10 @@ class TtDilepEvtSolution {
   //-------------------------------------------
   // get info on the W decays
   //-------------------------------------------
-  std::string getWpDecay() const { return wpDecay_; }
-  std::string getWmDecay() const { return wmDecay_; }
+  std::string getWpDecay() const { return wpLepType_==WDecay::kNone ? "NotDefined" : WDecay::leptonName(wpLepType_); }
+  std::string getWmDecay() const { return wmLepType_==WDecay::kNone ? "NotDefined" : WDecay::leptonName(wmLepType_); }
+  WDecay::LeptonType getWpLeptonType() const { return wpLepType_; }
+  WDecay::LeptonType getWmLeptonType() const { return wmLepType_; }
 
   //-------------------------------------------
   // miscellaneous
@@ -124,17 +128,17 @@ class TtDilepEvtSolution {
   void setBbar(const edm::Handle<std::vector<pat::Jet> >& jet, int i)
   { jetBbar_ = edm::Ref<std::vector<pat::Jet> >(jet, i); };
   void setMuonp(const edm::Handle<std::vector<pat::Muon> >& muon, int i)
-  { muonp_ = edm::Ref<std::vector<pat::Muon> >(muon, i); wpDecay_ = "muon"; };
+  { muonp_ = edm::Ref<std::vector<pat::Muon> >(muon, i); wpLepType_ = WDecay::kMuon; };
   void setMuonm(const edm::Handle<std::vector<pat::Muon> >& muon, int i)
-  { muonm_ = edm::Ref<std::vector<pat::Muon> >(muon, i); wmDecay_ = "muon"; }
+  { muonm_ = edm::Ref<std::vector<pat::Muon> >(muon, i); wmLepType_ = WDecay::kMuon; }
   void setTaup(const edm::Handle<std::vector<pat::Tau> >& tau, int i)
-  { taup_ = edm::Ref<std::vector<pat::Tau> >(tau, i); wpDecay_ = "tau"; }
+  { taup_ = edm::Ref<std::vector<pat::Tau> >(tau, i); wpLepType_ = WDecay::kTau; }
   void setTaum(const edm::Handle<std::vector<pat::Tau> >& tau, int i)
-  { taum_ = edm::Ref<std::vector<pat::Tau> >(tau, i); wmDecay_ = "tau"; }
+  { taum_ = edm::Ref<std::vector<pat::Tau> >(tau, i); wmLepType_ = WDecay::kTau; }
   void setElectronp(const edm::Handle<std::vector<pat::Electron> >& elec, int i)
-  { elecp_ = edm::Ref<std::vector<pat::Electron> >(elec, i); wpDecay_ = "electron"; };
+  { elecp_ = edm::Ref<std::vector<pat::Electron> >(elec, i); wpLepType_ = WDecay::kElec; };
   void setElectronm(const edm::Handle<std::vector<pat::Electron> >& elec, int i)
-  { elecm_ = edm::Ref<std::vector<pat::Electron> >(elec, i); wmDecay_ = "electron"; };
+  { elecm_ = edm::Ref<std::vector<pat::Electron> >(elec, i); wmLepType_ = WDecay::kElec; };
   void setMET(const edm::Handle<std::vector<pat::MET> >& met, int i)
   { met_ = edm::Ref<std::vector<pat::MET> >(met, i); };
 
@@ -158,6 +162,8 @@ class TtDilepEvtSolution {
   // particle content
   //-------------------------------------------
   edm::RefProd<TtGenEvent>            theGenEvt_;
+  /// resolved product of theGenEvt_ (transient)
+  TopRefProdCache<TtGenEvent>         theGenEvtCache_;
   edm::Ref<std::vector<pat::Electron> > elecp_, elecm_;
   edm::Ref<std::vector<pat::Muon> > muonp_, muonm_;
   edm::Ref<std::vector<pat::Tau> > taup_, taum_;
@@ -168,8 +174,8 @@ class TtDilepEvtSolution {
   // miscellaneous
   //-------------------------------------------
   int jetCorrScheme_;
-  std::string wpDecay_;
-  std::string wmDecay_;      
+  WDecay::LeptonType wpLepType_;
+  WDecay::LeptonType wmLepType_;
   bool bestSol_;
   double topmass_;
   double weightmax_;
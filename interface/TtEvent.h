@@ -8,6 +8,13 @@
 #include "DataFormats/Common/interface/RefProd.h"
 #include "DataFormats/Candidate/interface/CompositeCandidate.h"
 #include "AnalysisDataFormats/TopObjects/interface/TtGenEvent.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtJetLepComb.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtHypoClassRegistry.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtHypoScoreColumns.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtHypoScoreRegistry.h"
+#include "AnalysisDataFormats/TopObjects/interface/TopCacheFlag.h"
+#include "AnalysisDataFormats/TopObjects/interface/TopRefProdCache.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtSystemKinematics.h"
 
 /**
    \class   TtEvent TtEvent.h "AnalysisDataFormats/TopObjects/interface/TtEvent.h"
@@ -27,16 +34,22 @@ namespace edm{
 class TtEvent {
 
  public:
-  /// supported classes of event hypotheses
+  /// built-in classes of event hypotheses
   enum HypoClassKey {kGeom, kWMassMaxSumPt, kMaxSumPtWMass, kGenMatch, kMVADisc, kKinFit, kKinSolution, kWMassDeltaTopMass, kHitFit};
+  /// dense integer ID of a class of event hypotheses; the built-in classes keep the values
+  /// of HypoClassKey, further classes get their ID from the TtHypoClassRegistry
+  typedef unsigned int HypoClassId;
   /// pair of hypothesis and lepton jet combinatorics for a given hypothesis
   typedef std::pair<reco::CompositeCandidate, std::vector<int> > HypoCombPair;
+  /// built-in per-hypothesis scores; each is a column of type double attached to the
+  /// hypothesis class it is computed for (see scoreName and scoreHypoClass)
+  enum HypoScoreKey {kFitChi2Score, kFitProbScore, kHitFitChi2Score, kHitFitProbScore, kHitFitMTScore, kHitFitSigMTScore,
+		     kGenMatchSumPtScore, kGenMatchSumDRScore, kMvaDiscScore};
 
  protected:
-   /// a lightweight map for selection type string label and enum value
-   struct HypoClassKeyStringToEnum { const char* label; HypoClassKey value; };
-   /// return the corresponding enum value from a string 
-   HypoClassKey hypoClassKeyFromString(const std::string& label) const;
+   /// return the ID of the hypothesis class with the given name (see TtHypoClassRegistry);
+   /// resolving the ID once and using it afterwards is faster
+   HypoClassId hypoClassKeyFromString(const std::string& label) const { return TtHypoClassRegistry::id(label); };
   
  public:
   /// empty constructor
@@ -48,129 +61,269 @@ class TtEvent {
   std::pair<WDecay::LeptonType, WDecay::LeptonType> lepDecays() const { return lepDecays_; }
   /// get event hypothesis; there can be more hypotheses of a certain 
   /// class (sorted by quality); per default the best hypothesis is returned
-  const reco::CompositeCandidate& eventHypo(const HypoClassKey& key, const unsigned& cmb=0) const { return (evtHyp_.find(key)->second)[cmb].first; };
+  const reco::CompositeCandidate& eventHypo(const HypoClassId& key, const unsigned& cmb=0) const { return evtHyp_[key][cmb]; };
   /// get TtGenEvent
   const edm::RefProd<TtGenEvent>& genEvent() const { return genEvt_; };
+  /// get the TtGenEvent product (0 if not set); it is resolved only once
+  const TtGenEvent* genEventProduct() const { return genEvtCache_.get(genEvt_); };
 
   /// check if hypothesis class 'key' was added to the event structure
   bool isHypoClassAvailable(const std::string& key) const { return isHypoClassAvailable( hypoClassKeyFromString(key) ); };
   /// check if hypothesis class 'key' was added to the event structure
-  bool isHypoClassAvailable(const HypoClassKey& key) const { return (evtHyp_.find(key)!=evtHyp_.end()); };
+  bool isHypoClassAvailable(const HypoClassId& key) const { return key<hypoClasses_.size() && hypoClasses_[key]; };
   // check if hypothesis 'cmb' is available within the hypothesis class
   bool isHypoAvailable(const std::string& key, const unsigned& cmb=0) const { return isHypoAvailable( hypoClassKeyFromString(key), cmb ); };
   /// check if hypothesis 'cmb' is available within the hypothesis class
-  bool isHypoAvailable(const HypoClassKey& key, const unsigned& cmb=0) const { return isHypoClassAvailable(key) ? (cmb<evtHyp_.find(key)->second.size()) : false; };
+  bool isHypoAvailable(const HypoClassId& key, const unsigned& cmb=0) const { return isHypoClassAvailable(key) ? (cmb<evtHyp_[key].size()) : false; };
   /// check if hypothesis 'cmb' within the hypothesis class was valid; if not it lead to an empty CompositeCandidate
   bool isHypoValid(const std::string& key, const unsigned& cmb=0) const { return isHypoValid( hypoClassKeyFromString(key), cmb ); };
   /// check if hypothesis 'cmb' within the hypothesis class was valid; if not it lead to an empty CompositeCandidate
-  bool isHypoValid(const HypoClassKey& key, const unsigned& cmb=0) const { return isHypoAvailable(key, cmb) ? !eventHypo(key, cmb).roles().empty() : false; };
+  bool isHypoValid(const HypoClassId& key, const unsigned& cmb=0) const { return isHypoAvailable(key, cmb) ? !eventHypo(key, cmb).roles().empty() : false; };
   /// return number of available hypothesis classes
-  unsigned int numberOfAvailableHypoClasses() const { return evtHyp_.size(); };
+  unsigned int numberOfAvailableHypoClasses() const;
+  /// return the IDs of all available hypothesis classes in ascending order
+  std::vector<HypoClassId> availableHypoClasses() const;
   /// return number of available hypotheses within a given hypothesis class
   unsigned int numberOfAvailableHypos(const std::string& key) const { return numberOfAvailableHypos( hypoClassKeyFromString(key) ); };
   /// return number of available hypotheses within a given hypothesis class
-  unsigned int numberOfAvailableHypos(const HypoClassKey& key) const { return isHypoAvailable(key) ? evtHyp_.find(key)->second.size() : 0; };
+  unsigned int numberOfAvailableHypos(const HypoClassId& key) const { return isHypoAvailable(key) ? evtHyp_[key].size() : 0; };
   /// return number of jets that were considered when building a given hypothesis
   int numberOfConsideredJets(const std::string& key) const { return numberOfConsideredJets(hypoClassKeyFromString(key) ); };
   /// return number of jets that were considered when building a given hypothesis
-  int numberOfConsideredJets(const HypoClassKey& key) const { return (isHypoAvailable(key) ? nJetsConsidered_.find(key)->second : -1); };
+  int numberOfConsideredJets(const HypoClassId& key) const { return (isHypoAvailable(key) && key<nJetsConsidered_.size() ? nJetsConsidered_[key] : -1); };
   /// return the vector of jet lepton combinatorics for a given hypothesis and class
   std::vector<int> jetLeptonCombination(const std::string& key, const unsigned& cmb=0) const { return jetLeptonCombination(hypoClassKeyFromString(key), cmb); };
   /// return the vector of jet lepton combinatorics for a given hypothesis and class
-  std::vector<int> jetLeptonCombination(const HypoClassKey& key, const unsigned& cmb=0) const { return (evtHyp_.find(key)->second)[cmb].second; };
+  std::vector<int> jetLeptonCombination(const HypoClassId& key, const unsigned& cmb=0) const { return jetLepComb(key, cmb).vector(); };
+  /// return a non-owning view of the jet lepton combinatorics for a given hypothesis and class
+  TtJetLepCombView jetLepComb(const std::string& key, const unsigned& cmb=0) const { return jetLepComb(hypoClassKeyFromString(key), cmb); };
+  /// return a non-owning view of the jet lepton combinatorics for a given hypothesis and class
+  TtJetLepCombView jetLepComb(const HypoClassId& key, const unsigned& cmb=0) const { return jetLepCombs_[key][cmb]; };
   /// return the sum pt of the generator match if available; -1 else
-  double genMatchSumPt(const unsigned& cmb=0) const { return (cmb<genMatchSumPt_.size() ? genMatchSumPt_[cmb] : -1.); };
+  double genMatchSumPt(const unsigned& cmb=0) const { return score(kGenMatchSumPtScore, cmb); };
   /// return the sum dr of the generator match if available; -1 else
-  double genMatchSumDR(const unsigned& cmb=0) const { return (cmb<genMatchSumDR_.size() ? genMatchSumDR_[cmb] : -1.); };
+  double genMatchSumDR(const unsigned& cmb=0) const { return score(kGenMatchSumDRScore, cmb); };
   /// return the label of the mva method in use for the jet parton association (if kMVADisc is not available the string is empty)
   std::string mvaMethod() const { return mvaMethod_; }
   /// return the mva discriminant value of hypothesis 'cmb' if available; -1 else
-  double mvaDisc(const unsigned& cmb=0) const { return (cmb<mvaDisc_.size() ? mvaDisc_[cmb] : -1.); }
+  double mvaDisc(const unsigned& cmb=0) const { return score(kMvaDiscScore, cmb); }
   /// return the chi2 of the kinematic fit of hypothesis 'cmb' if available; -1 else
-  double fitChi2(const unsigned& cmb=0) const { return (cmb<fitChi2_.size() ? fitChi2_[cmb] : -1.); }
+  double fitChi2(const unsigned& cmb=0) const { return score(kFitChi2Score, cmb); }
   /// return the hitfit chi2 of hypothesis 'cmb' if available; -1 else
-  double hitFitChi2(const unsigned& cmb=0) const { return (cmb<hitFitChi2_.size() ? hitFitChi2_[cmb] : -1.); }
+  double hitFitChi2(const unsigned& cmb=0) const { return score(kHitFitChi2Score, cmb); }
   /// return the fit probability of hypothesis 'cmb' if available; -1 else
-  double fitProb(const unsigned& cmb=0) const { return (cmb<fitProb_.size() ? fitProb_[cmb] : -1.); }
+  double fitProb(const unsigned& cmb=0) const { return score(kFitProbScore, cmb); }
   /// return the hitfit probability of hypothesis 'cmb' if available; -1 else
-  double hitFitProb(const unsigned& cmb=0) const { return (cmb<hitFitProb_.size() ? hitFitProb_[cmb] : -1.); }
+  double hitFitProb(const unsigned& cmb=0) const { return score(kHitFitProbScore, cmb); }
   /// return the hitfit top mass of hypothesis 'cmb' if available; -1 else
-  double hitFitMT(const unsigned& cmb=0) const { return (cmb<hitFitMT_.size() ? hitFitMT_[cmb] : -1.); }
+  double hitFitMT(const unsigned& cmb=0) const { return score(kHitFitMTScore, cmb); }
   /// return the hitfit top mass uncertainty of hypothesis 'cmb' if available; -1 else
-  double hitFitSigMT(const unsigned& cmb=0) const { return (cmb<hitFitSigMT_.size() ? hitFitSigMT_[cmb] : -1.); }
+  double hitFitSigMT(const unsigned& cmb=0) const { return score(kHitFitSigMTScore, cmb); }
   /// return the hypothesis in hypothesis class 'key2', which corresponds to hypothesis 'hyp1' in hypothesis class 'key1'
   int correspondingHypo(const std::string& key1, const unsigned& hyp1, const std::string& key2) const { return correspondingHypo(hypoClassKeyFromString(key1), hyp1, hypoClassKeyFromString(key2) ); };
   /// return the hypothesis in hypothesis class 'key2', which corresponds to hypothesis 'hyp1' in hypothesis class 'key1'
-  int correspondingHypo(const HypoClassKey& key1, const unsigned& hyp1, const HypoClassKey& key2) const;
+  int correspondingHypo(const HypoClassId& key1, const unsigned& hyp1, const HypoClassId& key2) const;
+  /// return the indices of all hypotheses with a value of score 'key' sorted from the best to the
+  /// worst value (ascending for chi2 and distances, descending for probabilities and discriminants;
+  /// ties keep the original order); the permutation is computed once and cached for all consumers,
+  /// safe for concurrent use
+  std::vector<unsigned int> ranking(const HypoScoreKey& key) const { return ranking(key, lowerIsBetter(key)); };
+  /// same as above with an explicit sort order
+  std::vector<unsigned int> ranking(const HypoScoreKey& key, const bool ascending) const;
+  /// fill the indices of the (at most) 'k' best hypotheses by score 'key' into 'idx'; only the 
+  /// first 'k' entries are sorted unless the full ranking was already computed before
+  void bestHypos(const HypoScoreKey& key, const unsigned int k, std::vector<unsigned int>& idx) const;
+  /// return the values of score 'key' for all hypotheses (empty if not available)
+  const std::vector<double>& scores(const HypoScoreKey& key) const;
+  /// return the value of score 'key' of hypothesis 'cmb' if available; -1 else
+  double score(const HypoScoreKey& key, const unsigned& cmb=0) const { const std::vector<double>& val=scores(key); return cmb<val.size() ? val[cmb] : -1.; };
+  /// return the index of the best hypothesis by score 'key'; -1 if the score is not available
+  int bestHypo(const HypoScoreKey& key) const { const std::vector<unsigned int> rank=ranking(key); return rank.empty() ? -1 : (int)rank.front(); };
+  /// check whether lower values of score 'key' are better
+  static bool lowerIsBetter(const HypoScoreKey& key);
+  /// return the name of the column of score 'key' (the name of its accessor, e.g. "fitChi2")
+  static const char* scoreName(const HypoScoreKey& key);
+  /// return the hypothesis class the column of score 'key' is attached to
+  static HypoClassId scoreHypoClass(const HypoScoreKey& key);
+
+  /// resolve score 'name' of hypothesis class 'key' with values of type T (double, float or
+  /// int) to a handle (see TtHypoScoreRegistry); resolve once per job, e.g. in the constructor
+  /// of a module, and use the handle for all events, the lookup in each event is O(1)
+  template <typename T> static TtScoreHandle<T> scoreHandle(const HypoClassId& key, const std::string& name)
+    { return TtScoreHandle<T>(TtHypoScoreRegistry::registerScore(key, name)); };
+  /// check if a score is available in the event with values of type T
+  template <typename T> bool isScoreAvailable(const TtScoreHandle<T>& score) const { return scoreColumn(score)>=0; };
+  /// return the values of a score for all hypotheses of its class (empty if not available)
+  template <typename T> const std::vector<T>& scores(const TtScoreHandle<T>& score) const
+    { const int column=scoreColumn(score); return column<0 ? TtHypoScoreColumns::noValues((const T*)0) : scoreColumns_.values<T>(column); };
+  /// return the value of a score of hypothesis 'cmb' if available; -1 else
+  template <typename T> T score(const TtScoreHandle<T>& score, const unsigned& cmb=0) const { const std::vector<T>& val=scores(score); return cmb<val.size() ? val[cmb] : T(-1); };
+  /// return the indices of all hypotheses sorted by a score (empty if not available); cached as above
+  template <typename T> std::vector<unsigned int> ranking(const TtScoreHandle<T>& score, const bool ascending) const
+    { const int column=scoreColumn(score); return column<0 ? std::vector<unsigned int>() : columnRanking(column, ascending); };
+  /// return all score columns of the event
+  const TtHypoScoreColumns& scoreColumns() const { return scoreColumns_; };
 
   /// get combined 4-vector of top and topBar of the given hypothesis
   const reco::Candidate* topPair(const std::string& key, const unsigned& cmb=0) const { return topPair(hypoClassKeyFromString(key), cmb); };
   /// get combined 4-vector of top and topBar of the given hypothesis
-  const reco::Candidate* topPair(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : (reco::Candidate*)&eventHypo(key,cmb); };
+  const reco::Candidate* topPair(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : (reco::Candidate*)&eventHypo(key,cmb); };
   /// get combined 4-vector of top and topBar from the TtGenEvent
-  const math::XYZTLorentzVector* topPair() const { return (!genEvt_ ? 0 : this->genEvent()->topPair()); };
+  const math::XYZTLorentzVector* topPair() const { return (!genEvt_ ? 0 : this->genEventProduct()->topPair()); };
+  /// get the derived kinematics of the ttbar system of the given hypothesis (invalid if the
+  /// hypothesis is not valid); they are computed for all hypotheses on first use and cached,
+  /// safe for concurrent use
+  TtSystemKinematics systemKinematics(const std::string& key, const unsigned& cmb=0) const { return systemKinematics(hypoClassKeyFromString(key), cmb); };
+  /// get the derived kinematics of the ttbar system of the given hypothesis
+  TtSystemKinematics systemKinematics(const HypoClassId& key, const unsigned& cmb=0) const;
 
   /// print pt, eta, phi, mass of a given candidate into an existing LogInfo
   void printParticle(edm::LogInfo &log, const char* name, const reco::Candidate* cand) const;
+  /// append pt, eta, phi, mass of a given candidate to a dump buffer (as JSON-like object if compact)
+  void dumpParticle(std::string& buffer, const char* name, const reco::Candidate* cand, const bool compact) const;
 
   /// set leptonic decay channels
   void setLepDecays(const WDecay::LeptonType& lepDecTop1, const WDecay::LeptonType& lepDecTop2) { lepDecays_=std::make_pair(lepDecTop1, lepDecTop2); };
   /// set TtGenEvent
-  void setGenEvent(const edm::Handle<TtGenEvent>& evt) { genEvt_=edm::RefProd<TtGenEvent>(evt); };
+  void setGenEvent(const edm::Handle<TtGenEvent>& evt) { genEvt_=edm::RefProd<TtGenEvent>(evt); genEvtCache_.reset(); };
   /// add new hypotheses
-  void addEventHypo(const HypoClassKey& key, const HypoCombPair hyp) { evtHyp_[key].push_back(hyp); };
+  void addEventHypo(const HypoClassId& key, const HypoCombPair& hyp) { addHypoClass(key); evtHyp_[key].push_back(hyp.first); jetLepCombs_[key].push_back(hyp.second); systemKinematicsFlag_.reset(); };
+  /// add a new, empty hypothesis with jet lepton combinatorics 'jetLepComb' to class 'key'
+  /// and return it to be filled in place; this avoids copying the candidate tree, the
+  /// reference is valid until the next hypothesis is added to the class unless enough
+  /// memory was reserved before
+  reco::CompositeCandidate& addEventHypo(const HypoClassId& key, const std::vector<int>& jetLepComb);
+  /// add all hypotheses of class 'key' in one go, 'jetLepCombs' holds the jet lepton 
+  /// combinatorics in the same order; the hypotheses are swapped into the event structure
+  /// without copying if the class is still empty, 'hyps' is left empty
+  void addEventHypos(const HypoClassId& key, std::vector<reco::CompositeCandidate>& hyps, const std::vector<std::vector<int> >& jetLepCombs);
+  /// reserve memory for 'n' hypotheses of class 'key'; without it the vector of
+  /// hypotheses reallocates and copies all candidate trees while it grows
+  void reserveEventHypos(const HypoClassId& key, const unsigned int n) { addHypoClass(key); evtHyp_[key].reserve(n); jetLepCombs_[key].reserve(n); };
+  /// set the values of a per-hypothesis score in one go; they are swapped into the
+  /// event structure without copying and 'val' is left with the previous values
+  void swapScores(const HypoScoreKey& key, std::vector<double>& val) { scoreVector(key).swap(val); resetRankings(); };
+  /// add score 'name' with values of type T to hypothesis class 'key' (if not yet available)
+  /// and return its handle; throws if the score is available with another type of values
+  template <typename T> TtScoreHandle<T> addScore(const HypoClassId& key, const std::string& name)
+    { TtScoreHandle<T> score=scoreHandle<T>(key, name); addedScores(score); return score; };
+  /// set the values of a score, one per hypothesis of its class; the score is added if not
+  /// yet available (the handle must be valid)
+  template <typename T> void setScores(const TtScoreHandle<T>& score, const std::vector<T>& val) { addedScores(score)=val; };
+  /// set the values of a score in one go; they are swapped in as above
+  template <typename T> void swapScores(const TtScoreHandle<T>& score, std::vector<T>& val) { addedScores(score).swap(val); };
   /// set number of jets considered when building a given hypothesis
-  void setNumberOfConsideredJets(const HypoClassKey& key, const unsigned int nJets) { nJetsConsidered_[key]=nJets; };
+  void setNumberOfConsideredJets(const HypoClassId& key, const unsigned int nJets) { if(nJetsConsidered_.size()<=key) nJetsConsidered_.resize(key+1, -1); nJetsConsidered_[key]=nJets; };
+  /// translate the IDs of all hypothesis classes of the event (hypotheses, scores and the
+  /// per-class settings), e.g. with the translation returned by TtHypoClassRegistry::import
+  /// for the TtHypoClassTable of the file the event was read from: entry i is the new ID
+  /// of class i; throws if the translation does not cover a class of the event
+  virtual void remapHypoClasses(const std::vector<unsigned int>& translation);
   /// set sum pt of kGenMatch hypothesis
-  void setGenMatchSumPt(const std::vector<double>& val) {genMatchSumPt_=val;};
+  void setGenMatchSumPt(const std::vector<double>& val) { scoreVector(kGenMatchSumPtScore)=val; resetRankings(); };
   /// set sum dr of kGenMatch hypothesis
-  void setGenMatchSumDR(const std::vector<double>& val) {genMatchSumDR_=val;};
+  void setGenMatchSumDR(const std::vector<double>& val) { scoreVector(kGenMatchSumDRScore)=val; resetRankings(); };
   /// set label of mva method for kMVADisc hypothesis
   void setMvaMethod(const std::string& name) { mvaMethod_=name; };
   /// set mva discriminant values of kMVADisc hypothesis
-  void setMvaDiscriminators(const std::vector<double>& val) { mvaDisc_=val; };
+  void setMvaDiscriminators(const std::vector<double>& val) { scoreVector(kMvaDiscScore)=val; resetRankings(); };
   /// set chi2 of kKinFit hypothesis
-  void setFitChi2(const std::vector<double>& val) { fitChi2_=val; };
+  void setFitChi2(const std::vector<double>& val) { scoreVector(kFitChi2Score)=val; resetRankings(); };
   /// set chi2 of kHitFit hypothesis
-  void setHitFitChi2(const std::vector<double>& val) { hitFitChi2_=val; };
+  void setHitFitChi2(const std::vector<double>& val) { scoreVector(kHitFitChi2Score)=val; resetRankings(); };
   /// set fit probability of kKinFit hypothesis
-  void setFitProb(const std::vector<double>& val) { fitProb_=val; };
+  void setFitProb(const std::vector<double>& val) { scoreVector(kFitProbScore)=val; resetRankings(); };
   /// set fit probability of kHitFit hypothesis
-  void setHitFitProb(const std::vector<double>& val) { hitFitProb_=val; };
+  void setHitFitProb(const std::vector<double>& val) { scoreVector(kHitFitProbScore)=val; resetRankings(); };
   /// set fitted top mass of kHitFit hypothesis
-  void setHitFitMT(const std::vector<double>& val) { hitFitMT_=val; };
+  void setHitFitMT(const std::vector<double>& val) { scoreVector(kHitFitMTScore)=val; resetRankings(); };
   /// set fitted top mass uncertainty of kHitFit hypothesis
-  void setHitFitSigMT(const std::vector<double>& val) { hitFitSigMT_=val; };
+  void setHitFitSigMT(const std::vector<double>& val) { scoreVector(kHitFitSigMTScore)=val; resetRankings(); };
 
  protected:
 
+  /// return the values of a built-in score; its column is added if not yet available
+  std::vector<double>& scoreVector(const HypoScoreKey& key);
+  /// return the index of the column of a built-in score; -1 if not available
+  int scoreColumn(const HypoScoreKey& key) const;
+  /// return the index of the column of a score with values of type T; -1 if not available
+  template <typename T> int scoreColumn(const TtScoreHandle<T>& score) const
+    { const int column=score.isValid() ? scoreColumns_.column(score.id()) : -1; return column>=0 && scoreColumns_.valueType(column)==TtHypoScoreColumns::typeOf((const T*)0) ? column : -1; };
+  /// return the values of a score to be modified; its column is added if not yet available
+  template <typename T> std::vector<T>& addedScores(const TtScoreHandle<T>& score)
+    { resetRankings(); return scoreColumns_.values<T>(scoreColumns_.add(score.id(), TtHypoScoreColumns::typeOf((const T*)0))); };
+  /// return the cached ranking of the hypotheses by the score in a given column
+  std::vector<unsigned int> columnRanking(const int column, const bool ascending) const;
+  /// invalidate all cached rankings; to be called whenever a score is modified
+  void resetRankings() { rankingsFlag_.reset(); };
+  /// make room for and flag hypothesis class 'key' as available
+  void addHypoClass(const HypoClassId& key);
+  /// move the entries of a vector indexed by HypoClassId to their translated IDs; new
+  /// entries are set to 'unset'
+  template <typename T> static void remapHypoClassVector(std::vector<T>& vec, const std::vector<unsigned int>& translation, const T& unset);
+  /// return the translated ID of hypothesis class 'key'; throws if it is not covered
+  static HypoClassId remappedHypoClass(const std::vector<unsigned int>& translation, const HypoClassId& key);
+  /// return top, anti-top and the charged leptons of their decays of a hypothesis (0 if
+  /// not available) to compute the kinematics of the ttbar system; the base class
+  /// provides none of them
+  virtual void systemCandidates(const reco::CompositeCandidate& /*hypo*/, const reco::Candidate*& top, const reco::Candidate*& topBar,
+				const reco::Candidate*& leptonBar, const reco::Candidate*& lepton) const { top=topBar=leptonBar=lepton=0; };
+  /// compute the derived kinematics of the ttbar system of a hypothesis
+  void computeSystemKinematics(const reco::CompositeCandidate& hypo, TtSystemKinematics& kinematics) const;
+
+  /// append printf-like formated text to a dump buffer
+  static void dumpFormat(std::string& buffer, const char* format, ...);
+  /// append the jet lepton combination of a hypothesis to a dump buffer (as JSON-like array if compact)
+  static void dumpJetLeptonCombination(std::string& buffer, const TtJetLepCombView& jets, const char* spacer, const bool compact);
+  /// return a short label for a given leptonic decay channel
+  static const char* lepDecayLabel(const WDecay::LeptonType& type);
+
   /// leptonic decay channels
   std::pair<WDecay::LeptonType, WDecay::LeptonType> lepDecays_;
   /// reference to TtGenEvent (has to be kept in the event!)
   edm::RefProd<TtGenEvent> genEvt_;
-  /// map of hypotheses; for each HypoClassKey a vector of 
-  /// hypothesis and their lepton jet combinatorics are kept
-  std::map<HypoClassKey, std::vector<HypoCombPair> > evtHyp_;
-  /// number of jets considered when building the hypotheses
-  std::map<HypoClassKey, int> nJetsConsidered_;
+  /// resolved product of genEvt_ (transient)
+  TopRefProdCache<TtGenEvent> genEvtCache_;
+  /// flags of the available hypothesis classes, indexed by HypoClassId
+  std::vector<unsigned char> hypoClasses_;
+  /// hypotheses; for each HypoClassId a vector of hypotheses is kept
+  std::vector<std::vector<reco::CompositeCandidate> > evtHyp_;
+  /// lepton jet combinatorics of the hypotheses; for each HypoClassId
+  /// they are kept packed in the order of the hypotheses
+  std::vector<TtJetLepCombBuffer> jetLepCombs_;
+  /// number of jets considered when building the hypotheses, indexed by
+  /// HypoClassId (-1 if not set)
+  std::vector<int> nJetsConsidered_;
   
-  /// result of kinematic fit
-  std::vector<double> fitChi2_;        
-  std::vector<double> hitFitChi2_;
-  /// result of kinematic fit
-  std::vector<double> fitProb_; 
-  std::vector<double> hitFitProb_;
-  /// result of hitfit
-  std::vector<double> hitFitMT_; 
-  std::vector<double> hitFitSigMT_; 
-  /// result of gen match
-  std::vector<double> genMatchSumPt_;  
-  /// result of gen match
-  std::vector<double> genMatchSumDR_;   
+  /// per-hypothesis scores of all hypothesis classes, including
+  /// the built-in ones (fit results, gen match, MVA discriminants)
+  TtHypoScoreColumns scoreColumns_;
   /// label of the MVA method
   std::string mvaMethod_;               
-  /// MVA discriminants
-  std::vector<double> mvaDisc_;         
+
+  /// cached rankings of the hypotheses by score, indexed by 2*column+ascending
+  /// (transient, reset whenever a score is modified)
+  mutable std::vector<std::vector<unsigned int> > rankings_;
+  /// state of each cached ranking and of the size of rankings_ (transient)
+  mutable std::vector<TopCacheFlag> rankingFlags_;
+  TopCacheFlag rankingsFlag_;
+  /// cached kinematics of the ttbar system of all hypotheses (transient,
+  /// reset whenever a hypothesis is added)
+  mutable std::vector<std::vector<TtSystemKinematics> > systemKinematics_;
+  TopCacheFlag systemKinematicsFlag_;
 };
 
+template <typename T>
+void
+TtEvent::remapHypoClassVector(std::vector<T>& vec, const std::vector<unsigned int>& translation, const T& unset)
+{
+  std::vector<T> remapped;
+  for(unsigned int id=0; id<vec.size(); ++id) {
+    const HypoClassId key = remappedHypoClass(translation, id);
+    if(remapped.size()<=key) remapped.resize(key+1, unset);
+    std::swap(remapped[key], vec[id]);
+  }
+  vec.swap(remapped);
+}
+
 #endif
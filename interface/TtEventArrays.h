@@ -0,0 +1,49 @@
+#ifndef TopObjects_TtEventArrays_h
+#define TopObjects_TtEventArrays_h
+
+#include <string>
+#include <vector>
+
+#include "AnalysisDataFormats/TopObjects/interface/TtEventColumnFiller.h"
+
+/**
+   \class   TtEventArrays TtEventArrays.h "AnalysisDataFormats/TopObjects/interface/TtEventArrays.h"
+
+   \brief   Extracts TtEvent quantities of a batch of events into contiguous arrays in memory
+
+   The columns are declared as described for the TtEventColumnFiller and kept as
+   TtColumnBuffer. Meant for python analyses in FWLite: all accessors are called in C++
+   for a whole batch of events in one call, and the arrays are handed to numpy without
+   copying, e.g.
+
+     arrays = ROOT.TtEventArrays(classes, quantities)
+     arrays.fill(events)   # std::vector<const TtEvent*>
+     mass = numpy.frombuffer(arrays.column("kKinFit.hadronicDecayTop.mass").floats().data(), ...)
+
+   The per-hypothesis arrays of an event start at the sum of the "<class>.nHypos" values
+   of the events before.
+*/
+
+class TtEventArrays : public TtEventColumnFiller {
+
+ public:
+  /// at most 'maxHypos' hypotheses of each class are extracted per event (all if 0)
+  TtEventArrays(const std::vector<std::string>& hypoClasses, const std::vector<std::string>& quantities, const unsigned int maxHypos=0);
+  /// default destructor
+  virtual ~TtEventArrays(){};
+
+  /// append the columns of an event
+  using TtEventColumnFiller::fill;
+  /// append the columns of a batch of events
+  void fill(const std::vector<const TtEvent*>& events);
+  /// return the column 'name'; throws if it is not declared
+  const TtColumnBuffer& column(const std::string& name) const;
+  /// remove all values to start a new batch, keeping the allocated memory
+  void clear();
+
+ protected:
+  /// create a new column in memory
+  virtual TtColumnSink* newColumn(const std::string& name, const TtColumnFile::ValueType type);
+};
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef TopObjects_TtEventColumnFiller_h
+#define TopObjects_TtEventColumnFiller_h
+
+#include <string>
+#include <vector>
+
+#include "AnalysisDataFormats/TopObjects/interface/TtEvent.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtColumnFile.h"
+
+/**
+   \class   TtEventColumnFiller TtEventColumnFiller.h "AnalysisDataFormats/TopObjects/interface/TtEventColumnFiller.h"
+
+   \brief   Base class to fill TtEvent quantities into columns of plain values
+
+   The columns are declared by a list of hypothesis classes and a list of quantities:
+
+    - "<role>.<quantity>" : kinematic quantity of a candidate of each hypothesis; the role
+                            is the name of the accessor of TtSemiLeptonicEvent, TtFullLeptonicEvent
+                            or TtFullHadronicEvent (e.g. "hadronicDecayTop", "wPlus"), "topPair"
+                            for the hypothesis itself or a '/' separated list of daughter roles
+                            (e.g. "HadTop/HadW"); quantities are pt, eta, phi, mass, px, py, pz,
+                            energy and rapidity
+    - "<score>"           : per-hypothesis score named as its accessor (e.g. "fitProb", "mvaDisc")
+                            or any further score column of the hypothesis class (see
+                            TtEvent::addScore), written as double; built-in scores are only
+                            available for the class they belong to (see TtEvent::scoreHypoClass)
+    - "valid"             : 1 for valid hypotheses, 0 else
+    - "gen.<role>.<quantity>", "gen.channel" : per-event quantities of the TtGenEvent; the role
+                            is the name of the TtGenEvent accessor (e.g. "hadronicDecayTop",
+                            "topPair"), the channel is 0 (no ttbar), 1 (full hadronic), 2 (semi-
+                            leptonic) or 3 (full leptonic)
+
+   Per-hypothesis columns are filled for every hypothesis class as "<class>.<quantity>"
+   (e.g. "kKinFit.hadronicDecayTop.mass"), together with the per-event column "<class>.nHypos",
+   which holds the number of hypotheses filled for the event. Per-event columns keep their name.
+   Candidates that are not available are filled as -999, scores that are not available as -1
+   (as by their accessors). Derived classes decide where the values go (see newColumn) and
+   have to call book() from their constructor.
+*/
+
+class TtEventColumnFiller {
+
+ public:
+  /// default destructor; deletes all columns
+  virtual ~TtEventColumnFiller();
+
+  /// append the columns of an event
+  void fill(const TtEvent& evt);
+  /// number of events filled so far
+  unsigned int numberOfEvents() const { return nEvents_; };
+  /// names of all columns in the order of booking
+  const std::vector<std::string>& columnNames() const { return names_; };
+
+ protected:
+  /// at most 'maxHypos' hypotheses of each class are filled per event (all if 0)
+  explicit TtEventColumnFiller(const unsigned int maxHypos);
+
+  /// declare all columns for the given hypothesis classes and quantities
+  void book(const std::vector<std::string>& hypoClasses, const std::vector<std::string>& quantities);
+  /// create the destination of the values of a new column
+  virtual TtColumnSink* newColumn(const std::string& name, const TtColumnFile::ValueType type) = 0;
+
+  /// all columns in the order of booking (owned) and their names
+  std::vector<TtColumnSink*> columns_;
+  std::vector<std::string> names_;
+  /// number of events filled so far
+  unsigned int nEvents_;
+
+ private:
+  /// not copyable
+  TtEventColumnFiller(const TtEventColumnFiller&);
+  TtEventColumnFiller& operator=(const TtEventColumnFiller&);
+
+  /// supported kinematic quantities
+  enum Kinematic { kPt, kEta, kPhi, kMass, kPx, kPy, kPz, kEnergy, kRapidity };
+  /// a column filled from a candidate (role>=0), a score (by its ID in the TtHypoScoreRegistry,
+  /// score>=0) or the validity of a hypothesis
+  struct HypoColumn { int role; int score; Kinematic kinematic; TtColumnSink* sink; };
+  /// a column of the gen event filled from a candidate (role>=0) or the channel code
+  struct GenColumn { int role; Kinematic kinematic; TtColumnSink* sink; };
+  /// all columns of a hypothesis class
+  struct HypoClass { TtEvent::HypoClassId key; TtColumnSink* nHypos; std::vector<HypoColumn> columns; };
+
+  /// return the value of a kinematic quantity
+  static double kinematic(const math::XYZTLorentzVector& p4, const Kinematic kinematic);
+  /// split "<role>.<quantity>" into role and kinematic quantity
+  static void splitQuantity(const std::string& quantity, std::string& role, Kinematic& kinematic);
+  /// create a new column and keep track of it
+  TtColumnSink* addColumn(const std::string& name, const TtColumnFile::ValueType type);
+
+  unsigned int maxHypos_;
+  /// role paths (daughter role names) of the hypothesis candidates in use
+  std::vector<std::vector<std::string> > rolePaths_;
+  std::vector<HypoClass> classes_;
+  std::vector<GenColumn> genColumns_;
+};
+
+#endif
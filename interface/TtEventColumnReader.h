@@ -0,0 +1,165 @@
+#ifndef TopObjects_TtEventColumnReader_h
+#define TopObjects_TtEventColumnReader_h
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "DataFormats/Math/interface/LorentzVector.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtColumnFile.h"
+
+/**
+   \class   TtColumnJaggedView TtEventColumnReader.h "AnalysisDataFormats/TopObjects/interface/TtEventColumnReader.h"
+
+   \brief   Non-owning per-event view on a per-hypothesis column
+
+   operator[] returns the values of all hypotheses of a given event, operator() the
+   value of a single hypothesis of a given event.
+*/
+
+template <typename T>
+class TtColumnJaggedView {
+
+ public:
+  /// empty view
+  TtColumnJaggedView() : offsets_(0) {};
+  /// view on 'values' split into events by 'offsets' (number of events + 1 entries)
+  TtColumnJaggedView(const TtColumnView<T>& values, const std::vector<uint64_t>& offsets) : values_(values), offsets_(&offsets) {};
+
+  /// number of events
+  unsigned int size() const { return offsets_ ? offsets_->size()-1 : 0; };
+  /// values of all hypotheses of event 'evt'
+  TtColumnView<T> operator[](const unsigned int evt) const { return values_.range((*offsets_)[evt], (*offsets_)[evt+1]-(*offsets_)[evt]); };
+  /// value of hypothesis 'cmb' of event 'evt'
+  const T& operator()(const unsigned int evt, const unsigned int cmb=0) const { return values_[(*offsets_)[evt]+cmb]; };
+  /// values of all hypotheses of all events
+  const TtColumnView<T>& values() const { return values_; };
+
+ private:
+  TtColumnView<T> values_;
+  const std::vector<uint64_t>* offsets_;
+};
+
+/**
+   \class   TtColumnP4View TtEventColumnReader.h "AnalysisDataFormats/TopObjects/interface/TtEventColumnReader.h"
+
+   \brief   Non-owning view on the four-vector components of a candidate
+
+   The components are kept in separate columns; operator[] combines them into a
+   LorentzVector on access.
+*/
+
+class TtColumnP4View {
+
+ public:
+  /// empty view
+  TtColumnP4View() {};
+  /// view on the px, py, pz and energy columns of a candidate
+  TtColumnP4View(const TtColumnView<float>& px, const TtColumnView<float>& py, const TtColumnView<float>& pz, const TtColumnView<float>& energy) :
+    px_(px), py_(py), pz_(pz), energy_(energy) {};
+
+  /// number of entries
+  unsigned int size() const { return px_.size(); };
+  /// four-vector of entry i
+  math::XYZTLorentzVector operator[](const unsigned int i) const { return math::XYZTLorentzVector(px_[i], py_[i], pz_[i], energy_[i]); };
+  /// the components
+  const TtColumnView<float>& px() const { return px_; };
+  const TtColumnView<float>& py() const { return py_; };
+  const TtColumnView<float>& pz() const { return pz_; };
+  const TtColumnView<float>& energy() const { return energy_; };
+
+ private:
+  TtColumnView<float> px_, py_, pz_, energy_;
+};
+
+/**
+   \class   TtEventColumnReader TtEventColumnReader.h "AnalysisDataFormats/TopObjects/interface/TtEventColumnReader.h"
+
+   \brief   Read-only access to the column files written by the TtEventFlattener
+
+   The column files of a directory are memory mapped when they are first requested
+   and the values are accessed in place without copying or deserialization. The
+   accessors are named as those of TtEvent and TtGenEvent; hypothesis classes are
+   given by the labels used when flattening (e.g. "kKinFit"). Per-hypothesis columns
+   are returned as TtColumnJaggedView, split into events by the "<class>.nHypos"
+   column. Per-event columns of the TtGenEvent are prefixed with "gen." (see
+   TtEventFlattener).
+
+   Views stay valid as long as the reader does. The reader caches the mapped files
+   and thus is not meant to be shared between threads.
+*/
+
+class TtEventColumnReader {
+
+ public:
+  /// read the column files in 'directory'
+  explicit TtEventColumnReader(const std::string& directory);
+  /// default destructor; unmaps all column files
+  ~TtEventColumnReader();
+
+  /// names of all columns in the directory
+  const std::vector<std::string>& columnNames() const { return columnNames_; };
+  /// check if a column is available
+  bool isColumnAvailable(const std::string& name) const;
+  /// number of events; 0 if there are no per-event columns
+  unsigned int numberOfEvents() const;
+
+  /// view on a per-event column; throws if it does not hold one entry per event
+  template <typename T> TtColumnView<T> column(const std::string& name) const
+    { const TtColumnView<T> values = reader(name).view<T>(); checkEntries(name, values.size(), numberOfEvents()); return values; };
+  /// view on a per-hypothesis column of a given hypothesis class; throws if it does not
+  /// hold one entry per hypothesis
+  template <typename T> TtColumnJaggedView<T> hypoColumn(const std::string& key, const std::string& quantity) const
+    { const std::string name = key+"."+quantity; const TtColumnView<T> values = reader(name).view<T>(); const std::vector<uint64_t>& sums = offsets(key);
+      checkEntries(name, values.size(), sums.back()); return TtColumnJaggedView<T>(values, sums); };
+
+  /// decay channel of the TtGenEvent: 0 (no ttbar), 1 (full hadronic), 2 (semi-leptonic) or 3 (full leptonic)
+  TtColumnView<int32_t> channel() const { return column<int32_t>("gen.channel"); };
+  /// four-vector of a TtGenEvent candidate given by the name of its accessor
+  TtColumnP4View genParticle(const std::string& role) const { return p4("gen."+role); };
+  /// four-vector of the top pair of the TtGenEvent
+  TtColumnP4View topPair() const { return genParticle("topPair"); };
+
+  /// number of hypotheses of class 'key' per event
+  TtColumnView<int32_t> numberOfAvailableHypos(const std::string& key) const { return column<int32_t>(key+".nHypos"); };
+  /// validity of the hypotheses of class 'key'
+  TtColumnJaggedView<int32_t> isHypoValid(const std::string& key) const { return hypoColumn<int32_t>(key, "valid"); };
+  /// kinematic quantity (e.g. "mass") of a hypothesis candidate given by the name of its accessor (or its role path)
+  TtColumnJaggedView<float> hypoParticle(const std::string& key, const std::string& role, const std::string& quantity) const
+    { return hypoColumn<float>(key, role+"."+quantity); };
+  /// kinematic quantity of the top pair of the hypotheses of class 'key'
+  TtColumnJaggedView<float> topPair(const std::string& key, const std::string& quantity) const { return hypoParticle(key, "topPair", quantity); };
+
+  /// per-hypothesis scores of class 'key'
+  TtColumnJaggedView<double> fitChi2(const std::string& key) const { return hypoColumn<double>(key, "fitChi2"); };
+  TtColumnJaggedView<double> fitProb(const std::string& key) const { return hypoColumn<double>(key, "fitProb"); };
+  TtColumnJaggedView<double> hitFitChi2(const std::string& key) const { return hypoColumn<double>(key, "hitFitChi2"); };
+  TtColumnJaggedView<double> hitFitProb(const std::string& key) const { return hypoColumn<double>(key, "hitFitProb"); };
+  TtColumnJaggedView<double> hitFitMT(const std::string& key) const { return hypoColumn<double>(key, "hitFitMT"); };
+  TtColumnJaggedView<double> hitFitSigMT(const std::string& key) const { return hypoColumn<double>(key, "hitFitSigMT"); };
+  TtColumnJaggedView<double> genMatchSumPt(const std::string& key) const { return hypoColumn<double>(key, "genMatchSumPt"); };
+  TtColumnJaggedView<double> genMatchSumDR(const std::string& key) const { return hypoColumn<double>(key, "genMatchSumDR"); };
+  TtColumnJaggedView<double> mvaDisc(const std::string& key) const { return hypoColumn<double>(key, "mvaDisc"); };
+
+ private:
+  /// not copyable
+  TtEventColumnReader(const TtEventColumnReader&);
+  TtEventColumnReader& operator=(const TtEventColumnReader&);
+
+  /// return the (cached) reader of a column
+  const TtColumnReader& reader(const std::string& name) const;
+  /// throw if column 'name' has not the expected number of entries
+  void checkEntries(const std::string& name, const uint64_t entries, const uint64_t expected) const;
+  /// return the (cached) offsets of the events in the per-hypothesis columns of class 'key'
+  const std::vector<uint64_t>& offsets(const std::string& key) const;
+  /// four-vector view of a per-event candidate with prefix 'name'
+  TtColumnP4View p4(const std::string& name) const;
+
+  std::string directory_;
+  std::vector<std::string> columnNames_;
+  /// mapped column files (owned) and event offsets by column name and hypothesis class
+  mutable std::map<std::string, TtColumnReader*> readers_;
+  mutable std::map<std::string, std::vector<uint64_t> > offsets_;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef TopObjects_TtEventFlattener_h
+#define TopObjects_TtEventFlattener_h
+
+#include <string>
+#include <vector>
+
+#include "AnalysisDataFormats/TopObjects/interface/TtEventColumnFiller.h"
+
+/**
+   \class   TtEventFlattener TtEventFlattener.h "AnalysisDataFormats/TopObjects/interface/TtEventFlattener.h"
+
+   \brief   Flattens TtEvents into binary column files
+
+   The columns are declared as described for the TtEventColumnFiller. Each column goes
+   into "<directory>/<column>.col" (see TtColumnFile), where the '/' of role paths is
+   replaced by ':'; the TtEventColumnReader maps the file names back to the column names.
+*/
+
+class TtEventFlattener : public TtEventColumnFiller {
+
+ public:
+  /// create the column files in 'directory'; at most 'maxHypos' hypotheses of each class
+  /// are written per event (all if 0); 'bufferSize' is the number of buffered values per column
+  TtEventFlattener(const std::string& directory, const std::vector<std::string>& hypoClasses, const std::vector<std::string>& quantities,
+		   const unsigned int maxHypos=0, const unsigned int bufferSize=8192);
+  /// default destructor; closes all column files
+  virtual ~TtEventFlattener(){};
+
+  /// write all buffered values and close the column files
+  void close();
+
+ protected:
+  /// create a new column file
+  virtual TtColumnSink* newColumn(const std::string& name, const TtColumnFile::ValueType type);
+
+ private:
+  std::string directory_;
+  unsigned int bufferSize_;
+};
+
+#endif
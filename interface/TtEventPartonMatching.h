@@ -0,0 +1,99 @@
+#ifndef TtEventPartonMatching_h
+#define TtEventPartonMatching_h
+
+#include "DataFormats/Candidate/interface/Candidate.h"
+
+#include <vector>
+
+/**
+   \class   TtEventPartonMatching TtEventPartonMatching.h "AnalysisDataFormats/TopObjects/interface/TtEventPartonMatching.h"
+
+   \brief   Matching of generator partons to jets in deltaR
+
+   The partons are given in the order of the vector returned by the vec() method of
+   TtSemiLepEvtPartons, TtFullHadEvtPartons or TtFullLepEvtPartons. The deltaR and the
+   (absolute) pt difference of all parton jet pairs are computed once in a structure
+   of arrays layout; the assignment is then solved by one of the algorithms:
+
+    - kGreedy      : iteratively match the parton jet pair closest in deltaR
+    - kUnambiguous : match a parton to a jet only if this is the only jet within maxDist
+                     of the parton and the parton is the only parton within maxDist of the jet
+    - kOptimal     : match as many pairs as possible with the smallest sum of deltaR
+
+   Pairs with a deltaR larger than maxDist (if positive) are not matched. The resulting
+   combination holds the index of the matched jet for each parton or -1 if no jet was
+   matched; it is given in the order of vec(), such that TtEventPartons::expand() can be
+   applied to insert the partons that were chosen to be ignored. Partons with vanishing
+   pt (as the dummy partons of vec()) are never matched.
+*/
+
+class TtEventPartonMatching {
+
+ public:
+  /// supported matching algorithms
+  enum Algorithm { kGreedy, kUnambiguous, kOptimal };
+
+ public:
+  /// match 'partons' to the first 'maxNJets' (all if negative) 'jets'
+  template <class JetCollection>
+  TtEventPartonMatching(const std::vector<const reco::Candidate*>& partons, const JetCollection& jets, const Algorithm algorithm=kGreedy,
+			const double maxDist=0.3, const int maxNJets=-1);
+  /// default destructor
+  ~TtEventPartonMatching(){};
+
+  /// number of partons and jets
+  unsigned int nPartons() const { return partonPt_.size(); };
+  unsigned int nJets() const { return jetPt_.size(); };
+  /// deltaR and absolute pt difference between parton i and jet j
+  double deltaR(const unsigned int i, const unsigned int j) const { return deltaR_[i*nJets()+j]; };
+  double deltaPt(const unsigned int i, const unsigned int j) const { return deltaPt_[i*nJets()+j]; };
+
+  /// index of the jet matched to each parton (-1 if not matched)
+  const std::vector<int>& combination() const { return combination_; };
+  /// index of the jet matched to parton i (-1 if not matched)
+  int jetIndex(const unsigned int i) const { return combination_[i]; };
+  /// number of partons without a matched jet
+  unsigned int numberOfUnmatchedPartons() const;
+  /// sum of deltaR and of the absolute pt differences over all matched pairs, as expected by
+  /// TtEvent::setGenMatchSumDR and TtEvent::setGenMatchSumPt; -1 if no pair was matched
+  double sumDeltaR() const { return sumDeltaR_; };
+  double sumDeltaPt() const { return sumDeltaPt_; };
+
+ private:
+  /// add a parton or jet
+  void addParton(const reco::Candidate::LorentzVector& p4);
+  void addJet(const reco::Candidate::LorentzVector& p4);
+  /// compute the deltaR and pt difference matrices and solve the assignment
+  void match(const Algorithm algorithm, const double maxDist);
+  /// the matching algorithms
+  void matchGreedy(const double maxDist);
+  void matchUnambiguous(const double maxDist);
+  void matchOptimal(const double maxDist);
+  /// check if a pair can be matched
+  bool isAllowed(const unsigned int i, const unsigned int j, const double maxDist) const
+    { return partonPt_[i]>0 && (maxDist<=0 || deltaR(i,j)<=maxDist); };
+
+  /// kinematics of partons and jets (structure of arrays)
+  std::vector<double> partonPt_, partonEta_, partonPhi_;
+  std::vector<double> jetPt_, jetEta_, jetPhi_;
+  /// deltaR and pt difference matrices (row major, one row per parton)
+  std::vector<double> deltaR_, deltaPt_;
+  /// result
+  std::vector<int> combination_;
+  double sumDeltaR_;
+  double sumDeltaPt_;
+};
+
+template <class JetCollection>
+TtEventPartonMatching::TtEventPartonMatching(const std::vector<const reco::Candidate*>& partons, const JetCollection& jets, const Algorithm algorithm,
+					     const double maxDist, const int maxNJets) :
+  sumDeltaR_(-1.), sumDeltaPt_(-1.)
+{
+  for(unsigned int i=0; i<partons.size(); ++i)
+    addParton(partons[i]->p4());
+  for(unsigned int j=0; j<jets.size() && (maxNJets<0 || (int)j<maxNJets); ++j)
+    addJet(jets[j].p4());
+  match(algorithm, maxDist);
+}
+
+#endif
@@ -14,6 +14,66 @@
 namespace reco { class Candidate; }
 class TtGenEvent;
 
+/**
+   \class   TtEventPartonCombinations TtEventPartons.h "AnalysisDataFormats/TopObjects/interface/TtEventPartons.h"
+
+   \brief   Enumerator of the symmetry-distinct assignments of jets to the partons of a TtEventPartons layout
+
+   Assignments that only differ by interchanging partons with symmetric roles (e.g. LightQ
+   and LightQBar) lead to the same event hypothesis. Of every such set only the assignment
+   that is lexicographically smallest (in the order of the parton enum) is returned; other
+   assignments are pruned while they are built up. Partons that were chosen to be ignored
+   do not get a jet assigned; of the symmetries and all their compositions, those that
+   would interchange an ignored parton with a used one are dropped.
+
+   The assignments are either returned one by one in the layout of the parton enum with the
+   dummy index -3 for ignored partons (as from TtEventPartons::expand), or in chunks of a
+   compact encoding with one byte per used parton, which can be distributed for scoring.
+*/
+
+class TtEventPartonCombinations {
+
+ public:
+  /// enumerate the assignments of 'nJets' jets to the partons that are not ignored; 'symmetries'
+  /// are permutations of the parton layout that leave the event hypothesis unchanged
+  TtEventPartonCombinations(const std::vector<bool>& ignorePartons, const std::vector<std::vector<unsigned int> >& symmetries, const unsigned int nJets);
+
+  /// number of jets
+  unsigned int nJets() const { return nJets_; };
+  /// number of partons that get a jet assigned (i.e. bytes per assignment in the compact encoding)
+  unsigned int nPartons() const { return partons_.size(); };
+  /// check if all assignments were returned
+  bool done() const { return done_; };
+  /// restart the enumeration
+  void reset();
+
+  /// get the next assignment in the layout of the parton enum; returns false if there are no more
+  bool next(std::vector<int>& comb);
+  /// append up to 'maxCombs' assignments to 'buffer' in compact encoding; returns the number appended
+  unsigned int next(std::vector<unsigned char>& buffer, const unsigned int maxCombs);
+  /// convert an assignment in compact encoding into the layout of the parton enum
+  void expand(const unsigned char* compact, std::vector<int>& comb) const;
+
+ private:
+  /// advance to the next assignment; returns false if there are no more
+  bool advance();
+  /// check if the first 'n' assigned partons can still be the smallest assignment of its set
+  bool isCanonical(const unsigned int n) const;
+
+  /// number of jets and size of the parton layout
+  unsigned int nJets_;
+  unsigned int nLayout_;
+  /// positions of the used partons in the layout
+  std::vector<unsigned int> partons_;
+  /// non-trivial symmetries as permutations of the used partons
+  std::vector<std::vector<unsigned int> > symmetries_;
+  /// current assignment, jets in use and depth of the enumeration
+  std::vector<int> jets_;
+  std::vector<bool> used_;
+  int depth_;
+  bool done_;
+};
+
 class TtEventPartons {
 
  public:
@@ -30,6 +90,11 @@ class TtEventPartons {
   /// insert dummy index -3 for all partons that were chosen to be ignored
   void expand(std::vector<int>& vec);
 
+  /// enumerator of the assignments of 'nJets' jets to the partons that are not ignored; assignments
+  /// that only differ by interchanging symmetric partons are returned only once if 'useSymmetries'
+  TtEventPartonCombinations combinations(const unsigned int nJets, const bool useSymmetries=true) const
+    { return TtEventPartonCombinations(ignorePartons_, useSymmetries ? symmetries_ : std::vector<std::vector<unsigned int> >(), nJets); };
+
  protected:
 
   /// return pointer to an empty reco::Candidate
@@ -40,6 +105,9 @@ class TtEventPartons {
 
   /// flag partons that were chosen not to be used
   std::vector<bool> ignorePartons_;
+  /// permutations of the partons that leave the event hypothesis unchanged (to be filled
+  /// in the derived classes); entry i gives the parton that takes the place of parton i
+  std::vector<std::vector<unsigned int> > symmetries_;
 
 };
 
@@ -0,0 +1,89 @@
+#ifndef TopObjects_TtEventSummary_h
+#define TopObjects_TtEventSummary_h
+
+#include <utility>
+#include <vector>
+
+#include "AnalysisDataFormats/TopObjects/interface/TtEvent.h"
+
+/**
+   \class   TtEventSummary TtEventSummary.h "AnalysisDataFormats/TopObjects/interface/TtEventSummary.h"
+
+   \brief   Compact summary of a TtEvent for fast pre-selection
+
+   Fixed size product of a few dozen bytes to be produced alongside any TtEvent, such
+   that selections on the decay channels, on the validity of the best hypotheses or on
+   their scores do not need to read the full event. It holds:
+
+    - the leptonic decay channels of the TtEvent and the decay channel of the TtGenEvent
+    - a bitmask of the available hypothesis classes and of those with a valid best
+      hypothesis; only classes with an ID below kMaxHypoClasses are recorded
+    - the value of each built-in score (TtEvent::HypoScoreKey) of the best hypothesis
+      of the class it is attached to
+    - the top pair mass of the best hypothesis of one hypothesis class chosen by the
+      producer and of the TtGenEvent
+
+   Values that are not available are given as -1 (as by the TtEvent accessors).
+*/
+
+class TtEventSummary {
+
+ public:
+  /// number of hypothesis classes recorded in the bitmasks
+  static const unsigned int kMaxHypoClasses = 32;
+  /// number of built-in scores
+  static const unsigned int kNumberOfScores = TtEvent::kMvaDiscScore+1;
+
+  /// empty constructor
+  TtEventSummary();
+  /// summarize 'evt'; the top pair mass is taken from the best hypothesis of class 'key'
+  TtEventSummary(const TtEvent& evt, const TtEvent::HypoClassId& key);
+  /// default destructor
+  ~TtEventSummary(){};
+
+  /// get leptonic decay channels
+  std::pair<WDecay::LeptonType, WDecay::LeptonType> lepDecays() const { return std::make_pair((WDecay::LeptonType)lepDecayTop1_, (WDecay::LeptonType)lepDecayTop2_); };
+  /// check if the TtGenEvent was available
+  bool hasGenEvent() const { return genChannel_>=0; };
+  /// decay channel of the TtGenEvent: 0 (no ttbar), 1 (full hadronic), 2 (semi-leptonic)
+  /// or 3 (full leptonic); -1 if the TtGenEvent was not available
+  int genChannel() const { return genChannel_; };
+  /// check if hypothesis class 'key' is available
+  bool isHypoClassAvailable(const TtEvent::HypoClassId& key) const { return key<kMaxHypoClasses && (availableHypoClasses_>>key & 1); };
+  /// check if the best hypothesis of class 'key' is valid
+  bool isHypoValid(const TtEvent::HypoClassId& key) const { return key<kMaxHypoClasses && (validHypoClasses_>>key & 1); };
+  /// bitmasks of the available hypothesis classes and of those with a valid best hypothesis (bit i for ID i)
+  unsigned int availableHypoClasses() const { return availableHypoClasses_; };
+  unsigned int validHypoClasses() const { return validHypoClasses_; };
+  /// return the value of score 'key' of the best hypothesis of its class; -1 if not available
+  double score(const TtEvent::HypoScoreKey& key) const { return (unsigned int)key<kNumberOfScores ? scores_[key] : -1.; };
+  /// return the hypothesis class of the top pair mass
+  TtEvent::HypoClassId topPairMassHypoClass() const { return topPairMassHypoClass_; };
+  /// return the top pair mass of the best hypothesis of class topPairMassHypoClass(); -1 if not valid
+  double topPairMass() const { return topPairMass_; };
+  /// return the top pair mass of the TtGenEvent; -1 if not available
+  double genTopPairMass() const { return genTopPairMass_; };
+
+  /// translate the IDs of the hypothesis classes (see TtEvent::remapHypoClasses); classes
+  /// the translation does not cover are kept, those moved beyond kMaxHypoClasses are dropped
+  void remapHypoClasses(const std::vector<unsigned int>& translation);
+
+ private:
+  /// leptonic decay channels (WDecay::LeptonType)
+  unsigned char lepDecayTop1_;
+  unsigned char lepDecayTop2_;
+  /// decay channel of the TtGenEvent (-1 if not available)
+  signed char genChannel_;
+  /// bitmasks of the available hypothesis classes and of those with a valid best hypothesis
+  unsigned int availableHypoClasses_;
+  unsigned int validHypoClasses_;
+  /// built-in scores of the best hypotheses in the order of TtEvent::HypoScoreKey
+  float scores_[kNumberOfScores];
+  /// hypothesis class of the top pair mass
+  unsigned int topPairMassHypoClass_;
+  /// top pair mass of the best hypothesis of that class and of the TtGenEvent
+  float topPairMass_;
+  float genTopPairMass_;
+};
+
+#endif
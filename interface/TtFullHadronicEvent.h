@@ -32,80 +32,90 @@ class TtFullHadronicEvent: public TtEvent {
   /// get top of the given hypothesis
   const reco::Candidate* top(const std::string& key, const unsigned& cmb=0) const { return top(hypoClassKeyFromString(key), cmb); };
   /// get top of the given hypothesis
-  const reco::Candidate* top(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : eventHypo(key,cmb). daughter(TtFullHadDaughter::Top); };
+  const reco::Candidate* top(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : eventHypo(key,cmb). daughter(TtFullHadDaughter::Top); };
   /// get b of the given hypothesis
   const reco::Candidate* b(const std::string& key, const unsigned& cmb=0) const { return b(hypoClassKeyFromString(key), cmb); };
   /// get b of the given hypothesis
-  const reco::Candidate* b(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : top(key,cmb)->daughter(TtFullHadDaughter::B); };
+  const reco::Candidate* b(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : top(key,cmb)->daughter(TtFullHadDaughter::B); };
 
   /// get light Q of the given hypothesis
   const reco::Candidate* lightQ(const std::string& key, const unsigned& cmb=0) const { return lightQ(hypoClassKeyFromString(key), cmb); };
   /// get light Q of the given hypothesis
-  const reco::Candidate* lightQ(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : wPlus(key,cmb)->daughter(TtFullHadDaughter::LightQ); };
+  const reco::Candidate* lightQ(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : wPlus(key,cmb)->daughter(TtFullHadDaughter::LightQ); };
 
   /// get light P of the given hypothesis
   const reco::Candidate* lightP(const std::string& key, const unsigned& cmb=0) const { return lightP(hypoClassKeyFromString(key), cmb); };
   /// get light P of the given hypothesis
-  const reco::Candidate* lightP(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : wMinus(key,cmb)->daughter(TtFullHadDaughter::LightP); };
+  const reco::Candidate* lightP(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : wMinus(key,cmb)->daughter(TtFullHadDaughter::LightP); };
 
   /// get Wplus of the given hypothesis
   const reco::Candidate* wPlus(const std::string& key, const unsigned& cmb=0) const { return wPlus(hypoClassKeyFromString(key), cmb); };
   /// get Wplus of the given hypothesis
-  const reco::Candidate* wPlus(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : top(key,cmb)->daughter(TtFullHadDaughter::WPlus); };
+  const reco::Candidate* wPlus(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : top(key,cmb)->daughter(TtFullHadDaughter::WPlus); };
 
   /// get anti-top of the given hypothesis
   const reco::Candidate* topBar(const std::string& key, const unsigned& cmb=0) const { return topBar(hypoClassKeyFromString(key), cmb); };
   /// get anti-top of the given hypothesis
-  const reco::Candidate* topBar(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : eventHypo(key,cmb). daughter(TtFullHadDaughter::TopBar); };
+  const reco::Candidate* topBar(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : eventHypo(key,cmb). daughter(TtFullHadDaughter::TopBar); };
   /// get anti-b of the given hypothesis
   const reco::Candidate* bBar(const std::string& key, const unsigned& cmb=0) const { return bBar(hypoClassKeyFromString(key), cmb); };
   /// get anti-b of the given hypothesis
-  const reco::Candidate* bBar(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : topBar(key,cmb)->daughter(TtFullHadDaughter::BBar  ); };
+  const reco::Candidate* bBar(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : topBar(key,cmb)->daughter(TtFullHadDaughter::BBar  ); };
 
   /// get light Q bar of the given hypothesis
   const reco::Candidate* lightQBar(const std::string& key, const unsigned& cmb=0) const { return lightQBar(hypoClassKeyFromString(key), cmb); };
   /// get light Q bar of the given hypothesis
-  const reco::Candidate* lightQBar(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : wPlus(key,cmb)->daughter(TtFullHadDaughter::LightQBar); };
+  const reco::Candidate* lightQBar(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : wPlus(key,cmb)->daughter(TtFullHadDaughter::LightQBar); };
 
   /// get light P bar of the given hypothesis
   const reco::Candidate* lightPBar(const std::string& key, const unsigned& cmb=0) const { return lightPBar(hypoClassKeyFromString(key), cmb); };
   /// get light P bar of the given hypothesis
-  const reco::Candidate* lightPBar(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : wMinus(key,cmb)->daughter(TtFullHadDaughter::LightPBar); };
+  const reco::Candidate* lightPBar(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : wMinus(key,cmb)->daughter(TtFullHadDaughter::LightPBar); };
 
   /// get Wminus of the given hypothesis
   const reco::Candidate* wMinus(const std::string& key, const unsigned& cmb=0) const { return wMinus(hypoClassKeyFromString(key), cmb); };
   /// get Wminus of the given hypothesis
-  const reco::Candidate* wMinus(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : topBar(key,cmb)->daughter(TtFullHadDaughter::WMinus); };
+  const reco::Candidate* wMinus(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : topBar(key,cmb)->daughter(TtFullHadDaughter::WMinus); };
 
   /// get top of the TtGenEvent
-  const reco::GenParticle* top        () const { return (!genEvt_ ? 0 : this->genEvent()->top()  ); };
+  const reco::GenParticle* top        () const { return (!genEvt_ ? 0 : this->genEventProduct()->top()  ); };
   /// get b of the TtGenEvent
-  const reco::GenParticle* b          () const { return (!genEvt_ ? 0 : this->genEvent()->b()    ); };
+  const reco::GenParticle* b          () const { return (!genEvt_ ? 0 : this->genEventProduct()->b()    ); };
 
   /// get light Q of the TtGenEvent
-  const reco::GenParticle* lightQ     () const { return (!genEvt_ ? 0 : this->genEvent()->daughterQuarkOfWPlus()   ); };
+  const reco::GenParticle* lightQ     () const { return (!genEvt_ ? 0 : this->genEventProduct()->daughterQuarkOfWPlus()   ); };
   /// get light P of the TtGenEvent
-  const reco::GenParticle* lightP     () const { return (!genEvt_ ? 0 : this->genEvent()->daughterQuarkOfWMinus()  ); };
+  const reco::GenParticle* lightP     () const { return (!genEvt_ ? 0 : this->genEventProduct()->daughterQuarkOfWMinus()  ); };
 
   /// get Wplus of the TtGenEvent
-  const reco::GenParticle* wPlus      () const { return (!genEvt_ ? 0 : this->genEvent()->wPlus()   ); };
+  const reco::GenParticle* wPlus      () const { return (!genEvt_ ? 0 : this->genEventProduct()->wPlus()   ); };
 
   /// get anti-top of the TtGenEvent
-  const reco::GenParticle* topBar     () const { return (!genEvt_ ? 0 : this->genEvent()->topBar()  ); };
+  const reco::GenParticle* topBar     () const { return (!genEvt_ ? 0 : this->genEventProduct()->topBar()  ); };
   /// get anti-b of the TtGenEvent
-  const reco::GenParticle* bBar       () const { return (!genEvt_ ? 0 : this->genEvent()->bBar()    ); };
+  const reco::GenParticle* bBar       () const { return (!genEvt_ ? 0 : this->genEventProduct()->bBar()    ); };
 
   /// get light Q bar of the TtGenEvent
-  const reco::GenParticle* lightQBar  () const { return (!genEvt_ ? 0 : this->genEvent()->daughterQuarkBarOfWPlus()   ); };
+  const reco::GenParticle* lightQBar  () const { return (!genEvt_ ? 0 : this->genEventProduct()->daughterQuarkBarOfWPlus()   ); };
   /// get light P bar of the TtGenEvent
-  const reco::GenParticle* lightPBar  () const { return (!genEvt_ ? 0 : this->genEvent()->daughterQuarkBarOfWMinus()  ); };
+  const reco::GenParticle* lightPBar  () const { return (!genEvt_ ? 0 : this->genEventProduct()->daughterQuarkBarOfWMinus()  ); };
 
   /// get Wminus of the TtGenEvent
-  const reco::GenParticle* wMinus     () const { return (!genEvt_ ? 0 : this->genEvent()->wMinus()  ); };
+  const reco::GenParticle* wMinus     () const { return (!genEvt_ ? 0 : this->genEventProduct()->wMinus()  ); };
 
   /// print full content of the structure as formated 
   /// LogInfo to the MessageLogger output for debugging  
   void print(const int verbosity=1) const;
+  /// format the full content of the structure into 'buffer' in a single pass; the
+  /// buffer is cleared but keeps its capacity, so that it can be reused from event
+  /// to event; if 'compact' is true a single JSON-like record is produced instead
+  void dump(std::string& buffer, const int verbosity=1, const bool compact=false) const;
+
+ protected:
+
+  /// top, anti-top and the charged leptons of their decays for the kinematics of the ttbar system
+  virtual void systemCandidates(const reco::CompositeCandidate& hypo, const reco::Candidate*& top, const reco::Candidate*& topBar,
+				const reco::Candidate*& leptonBar, const reco::Candidate*& lepton) const;
 };
 
 #endif
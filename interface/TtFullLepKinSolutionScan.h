@@ -0,0 +1,97 @@
+#ifndef TtFullLepKinSolutionScan_h
+#define TtFullLepKinSolutionScan_h
+
+#include <vector>
+
+#include "DataFormats/Math/interface/LorentzVector.h"
+
+class TtDilepEvtSolution;
+class TtFullLeptonicEvent;
+
+/**
+   \class   TtFullLepKinSolutionScan TtFullLepKinSolutionScan.h "AnalysisDataFormats/TopObjects/interface/TtFullLepKinSolutionScan.h"
+
+   \brief   Scan of the analytic dilepton kinematic solutions over a grid of top mass hypotheses
+
+   For an assignment of the b and anti-b jets the momenta of neutrino and anti-neutrino
+   are fixed by the W and top mass constraints of both decay branches and the measured
+   MET. The constraints of each branch define a conic in the transverse momentum plane
+   of the neutrino; the solutions are the intersections of the two conics, given by the
+   real roots of a quartic polynomial. Every solution is weighted by the product of the
+   expected energy spectra of neutrino and anti-neutrino, parametrized as Landau functions
+   of the energy with most probable value and width linear in the top mass:
+
+     w(E) = Landau(E, p0+p1*mTop, p2+p3*mTop)
+
+   For each assignment the solution with the largest weight over all grid points is kept,
+   as stored in TtFullLeptonicEvent::solWeight and TtDilepEvtSolution::getRecWeightMax.
+   The parts of the conics that do not depend on the top mass are computed once per
+   assignment; the mass dependent parts are computed for all grid points in one loop.
+   Assignments are independent of each other and can be scanned separately.
+*/
+
+class TtFullLepKinSolutionScan {
+
+ public:
+  /// result of the scan for a single assignment
+  struct Solution {
+    Solution() : weight(-1.), topMass(-1.) {};
+    /// check if there was any solution on the grid
+    bool isValid() const { return weight>0; };
+    /// largest weight and corresponding top mass and neutrino momenta
+    double weight;
+    double topMass;
+    math::XYZTLorentzVector neutrino, neutrinoBar;
+  };
+
+ public:
+  /// scan the top masses from 'topMassBegin' to 'topMassEnd' in steps of 'topMassStep'; 'nuParameters'
+  /// are the four parameters p0 to p3 of the neutrino energy spectrum (see above)
+  TtFullLepKinSolutionScan(const double topMassBegin, const double topMassEnd, const double topMassStep, const std::vector<double>& nuParameters,
+			   const double wMass=80.4);
+  /// default destructor
+  ~TtFullLepKinSolutionScan(){};
+
+  /// top masses of the grid
+  const std::vector<double>& topMasses() const { return topMasses_; };
+  /// scan a single assignment: 'b' and 'leptonBar' from the top decay, 'bBar' and 'lepton' from the anti-top decay
+  Solution solve(const math::XYZTLorentzVector& b, const math::XYZTLorentzVector& bBar, const math::XYZTLorentzVector& leptonBar,
+		 const math::XYZTLorentzVector& lepton, const double metPx, const double metPy) const;
+  /// scan all assignments of two different jets out of the first 'maxNJets' (all if negative) 'jets' to
+  /// b and anti-b; 'combs' receives the indices of the b and anti-b jet of each assignment
+  std::vector<Solution> solve(const std::vector<math::XYZTLorentzVector>& jets, const math::XYZTLorentzVector& leptonBar,
+			      const math::XYZTLorentzVector& lepton, const double metPx, const double metPy,
+			      std::vector<std::pair<unsigned int, unsigned int> >& combs, const int maxNJets=-1) const;
+
+  /// index of the solution with the largest weight; -1 if there is no valid solution
+  static int best(const std::vector<Solution>& solutions);
+  /// weights of all solutions (-1 for assignments without solution)
+  static std::vector<double> weights(const std::vector<Solution>& solutions);
+  /// store the weights of all solutions as the weights of the kKinSolution hypotheses
+  static void fill(TtFullLeptonicEvent& evt, const std::vector<Solution>& solutions);
+  /// store top mass and weight of a solution
+  static void fill(TtDilepEvtSolution& sol, const Solution& solution);
+
+ private:
+  /// parametrization of the energy E of the neutrino and the conic in its transverse
+  /// momentum (x, y); E and pz are linear in x and y: E = e0+ex*x+ey*y, pz = z0+zx*x+zy*y
+  struct Branch {
+    /// false if the constraints are degenerate
+    bool valid;
+    double ex, ey, zx, zy;
+    /// e0 and z0 are linear in the top mass squared: e0 = e0Const+e0Slope*mTop^2
+    double e0Const, e0Slope, z0Const, z0Slope;
+  };
+  /// parametrization of a decay branch of lepton and b
+  Branch branch(const math::XYZTLorentzVector& lepton, const math::XYZTLorentzVector& b) const;
+  /// real roots of the polynomial c[0]+c[1]*x+...+c[4]*x^4
+  static void realRoots(const double* c, std::vector<double>& roots);
+  /// expected neutrino energy spectrum
+  double nuWeight(const double energy, const double topMass) const;
+
+  double wMass_;
+  std::vector<double> topMasses_;
+  std::vector<double> nuParameters_;
+};
+
+#endif
@@ -3,6 +3,8 @@
 
 #include "CommonTools/CandUtils/interface/pdgIdUtils.h"
 #include "AnalysisDataFormats/TopObjects/interface/TopGenEvent.h"
+#include "AnalysisDataFormats/TopObjects/interface/TopCacheFlag.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtSystemKinematics.h"
 
 /**
    \class   TtGenEvent TtGenEvent.h "AnalysisDataFormats/TopObjects/interface/TtGenEvent.h"
@@ -70,21 +72,41 @@ class TtGenEvent: public TopGenEvent {
   const reco::GenParticle* hadronicDecayQuark(bool invertFlavor=false) const;
   /// get light anti-quark of hadronic decay branch
   const reco::GenParticle* hadronicDecayQuarkBar() const {return hadronicDecayQuark(true); };
-  /// gluons as radiated from the leptonicly decaying top quark
+  /// gluons as radiated from the leptonicly decaying top quark; deprecated: the returned
+  /// particles are copies owned by the caller, use leptonicDecayTopGluons instead
   std::vector<const reco::GenParticle*> leptonicDecayTopRadiation(bool excludeTauLeptons=false) const;
-  /// gluons as radiated from the hadronicly decaying top quark
+  /// gluons as radiated from the hadronicly decaying top quark; deprecated: the returned
+  /// particles are copies owned by the caller, use hadronicDecayTopGluons instead
   std::vector<const reco::GenParticle*> hadronicDecayTopRadiation(bool excludeTauLeptons=false) const;
-  /// get lepton for semi-leptonic or full leptonic decays
+  /// gluons as radiated from the leptonicly decaying top quark; they are part of the
+  /// decay chain (see TopGenEvent::radiation) and must not be deleted
+  std::vector<const reco::GenParticle*> leptonicDecayTopGluons(bool excludeTauLeptons=false) const { return radiation(leptonicDecayTop(excludeTauLeptons), TopRadiationIndex::kGluon); };
+  /// gluons as radiated from the hadronicly decaying top quark; they are part of the
+  /// decay chain (see TopGenEvent::radiation) and must not be deleted
+  std::vector<const reco::GenParticle*> hadronicDecayTopGluons(bool excludeTauLeptons=false) const { return radiation(hadronicDecayTop(excludeTauLeptons), TopRadiationIndex::kGluon); };
+  /// get lepton for semi-leptonic or full leptonic decays; 0 for a tau if taus are excluded
   const reco::GenParticle* lepton(bool excludeTauLeptons=false) const;
-  /// get anti-lepton for semi-leptonic or full leptonic decays
+  /// get anti-lepton for semi-leptonic or full leptonic decays; 0 for a tau if taus are excluded
   const reco::GenParticle* leptonBar(bool excludeTauLeptons=false) const;
-  /// get neutrino for semi-leptonic or full leptonic decays
+  /// get neutrino for semi-leptonic or full leptonic decays; 0 if the W decays to a tau and
+  /// taus are excluded
   const reco::GenParticle* neutrino(bool excludeTauLeptons=false) const;
-  /// get anti-neutrino for semi-leptonic or full leptonic decays
+  /// get anti-neutrino for semi-leptonic or full leptonic decays; 0 if the W decays to a tau
+  /// and taus are excluded
   const reco::GenParticle* neutrinoBar(bool excludeTauLeptons=false) const;
+  /// get the electron or muon the lepton decays to: the lepton itself or the lepton of the
+  /// leptonic tau decay; 0 for hadronic tau decays (needs the tau decay in the decay chain)
+  const reco::GenParticle* visibleLepton() const { return leptonRole(kVisibleLepton); };
+  /// get the positron or anti-muon the anti-lepton decays to: the anti-lepton itself or the
+  /// anti-lepton of the leptonic tau decay; 0 for hadronic tau decays
+  const reco::GenParticle* visibleLeptonBar() const { return leptonRole(kVisibleLeptonBar); };
 
   /// return combined 4-vector of top and topBar
   const math::XYZTLorentzVector* topPair() const { return isTtBar() ? &topPair_ : 0; };
+  /// return the derived kinematics of the ttbar system with the charged leptons as spin
+  /// analyzers (invalid if not ttbar); computed on first use and cached, safe for
+  /// concurrent use
+  TtSystemKinematics systemKinematics() const;
 
  protected:
 
@@ -93,9 +115,29 @@ class TtGenEvent: public TopGenEvent {
 
  private:
 
-  /// check whether the number of leptons among the daughters of the W boson is nlep
+  /// leptonic decay products of the W bosons as cached in leptons_
+  enum LeptonRole { kLepton, kLeptonBar, kNeutrino, kNeutrinoBar, kVisibleLepton, kVisibleLeptonBar, kNumberOfLeptonRoles };
+
+  /// return the candidate of a given role; the roles are resolved on first use
+  const reco::GenParticle* leptonRole(LeptonRole role) const;
+  /// resolve the leptonic decays of both W bosons, following tau decays, in a single
+  /// pass over the decay chain
+  void resolveLeptons(const reco::GenParticle* leptons[kNumberOfLeptonRoles]) const;
+  /// transient cache of the resolved leptonic decays (not persistent)
+  mutable const reco::GenParticle* leptons_[kNumberOfLeptonRoles];
+  /// transient state of leptons_ (not persistent)
+  TopCacheFlag leptonsFlag_;
+
+  /// compute the derived kinematics of the ttbar system
+  void computeSystemKinematics(TtSystemKinematics& kinematics) const;
+  /// transient cache of the derived kinematics of the ttbar system (not persistent)
+  mutable TtSystemKinematics systemKinematics_;
+  /// transient state of systemKinematics_ (not persistent)
+  TopCacheFlag systemKinematicsFlag_;
+
+  /// check whether the number of leptons among the daughters of the W bosons is nlep
   /// or not; there is an option to exclude taus from the list of leptons to consider
-  bool isNumberOfLeptons(bool excludeTauLeptons, int nlep) const {return excludeTauLeptons ? (numberOfLeptons()-numberOfLeptons(WDecay::kTau))==nlep : numberOfLeptons()==nlep;}
+  bool isNumberOfLeptons(bool excludeTauLeptons, int nlep) const {return ((lepton(excludeTauLeptons) ? 1 : 0) + (leptonBar(excludeTauLeptons) ? 1 : 0))==nlep;}
 };
 
 inline bool
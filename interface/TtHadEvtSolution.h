@@ -15,6 +15,7 @@
 #include "DataFormats/Candidate/interface/Particle.h"
 #include "DataFormats/HepMCCandidate/interface/GenParticle.h"
 #include "AnalysisDataFormats/TopObjects/interface/TtGenEvent.h"
+#include "AnalysisDataFormats/TopObjects/interface/TopRefProdCache.h"
 
 #include "DataFormats/PatCandidates/interface/Particle.h"
 #include "DataFormats/PatCandidates/interface/Jet.h"
@@ -49,12 +50,12 @@ class TtHadEvtSolution {
   // get the matched gen particles
   //-------------------------------------------
   const edm::RefProd<TtGenEvent> & getGenEvent() const { return theGenEvt_; };
-  const reco::GenParticle * getGenHadb() const { if (!theGenEvt_) return 0; else return theGenEvt_->b(); };
-  const reco::GenParticle * getGenHadbbar() const { if (!theGenEvt_) return 0; else return theGenEvt_->bBar(); };
-  const reco::GenParticle * getGenHadp() const { if (!theGenEvt_) return 0; else return theGenEvt_->daughterQuarkOfWPlus(); };
-  const reco::GenParticle * getGenHadq() const { if (!theGenEvt_) return 0; else return theGenEvt_->daughterQuarkBarOfWPlus(); };
-  const reco::GenParticle * getGenHadj() const { if (!theGenEvt_) return 0; else return theGenEvt_->daughterQuarkOfWMinus(); };
-  const reco::GenParticle * getGenHadk() const { if (!theGenEvt_) return 0; else return theGenEvt_->daughterQuarkBarOfWMinus(); };
+  const reco::GenParticle * getGenHadb() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->b(); };
+  const reco::GenParticle * getGenHadbbar() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->bBar(); };
+  const reco::GenParticle * getGenHadp() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->daughterQuarkOfWPlus(); };
+  const reco::GenParticle * getGenHadq() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->daughterQuarkBarOfWPlus(); };
+  const reco::GenParticle * getGenHadj() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->daughterQuarkOfWMinus(); };
+  const reco::GenParticle * getGenHadk() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->daughterQuarkBarOfWMinus(); };
   
   //-------------------------------------------
   // get (un-)/calibrated reco objects
@@ -101,6 +102,21 @@ class TtHadEvtSolution {
   //-------------------------------------------
   std::string getDecay() const { return decay_; }
 
+  //-------------------------------------------
+  // get four-vectors of the composites without 
+  // copying pat::Jets or creating reco::Particles
+  //-------------------------------------------
+  enum P4Level { kRec, kCal, kFit };
+  struct CompositeP4 {
+    math::XYZTLorentzVector hadt, hadtbar, hadW_plus, hadW_minus;
+  };
+  math::XYZTLorentzVector getHadtP4(P4Level level) const;
+  math::XYZTLorentzVector getHadtbarP4(P4Level level) const;
+  math::XYZTLorentzVector getHadW_plusP4(P4Level level) const;
+  math::XYZTLorentzVector getHadW_minusP4(P4Level level) const;
+  // all composites in one call
+  void getCompositeP4(CompositeP4& p4, P4Level level) const;
+
   //-------------------------------------------  
   // get info on the matching
   //-------------------------------------------  
@@ -226,10 +242,18 @@ class TtHadEvtSolution {
   
  private:
 
+  //-------------------------------------------
+  // four-vector of a single jet on a given level
+  //-------------------------------------------
+  math::XYZTLorentzVector getJetP4(const edm::Ref<std::vector<pat::Jet> >& jet, const std::vector<pat::Particle>& fit,
+				   const char* flavor, P4Level level) const;
+
   //-------------------------------------------  
   // particle content
   //-------------------------------------------  
   edm::RefProd<TtGenEvent> theGenEvt_;
+  /// resolved product of theGenEvt_ (transient)
+  TopRefProdCache<TtGenEvent> theGenEvtCache_;
   edm::Ref<std::vector<pat::Jet> > hadb_, hadp_, hadq_, hadbbar_,hadj_, hadk_;
   std::vector<pat::Particle> fitHadb_, fitHadp_, fitHadq_, fitHadbbar_, fitHadj_, fitHadk_;
   
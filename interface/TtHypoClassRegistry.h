@@ -0,0 +1,73 @@
+#ifndef TopObjects_TtHypoClassRegistry_h
+#define TopObjects_TtHypoClassRegistry_h
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "AnalysisDataFormats/TopObjects/interface/TtHypoClassTable.h"
+
+/**
+   \class   TtHypoClassRegistry TtHypoClassRegistry.h "AnalysisDataFormats/TopObjects/interface/TtHypoClassRegistry.h"
+
+   \brief   Job-wide registry of the hypothesis classes of the TtEvent
+
+   Assigns dense integer IDs to the names of hypothesis classes. The built-in classes
+   are registered from the start under the names of TtEvent::HypoClassKey ("kGeom",
+   "kWMassMaxSumPt", ...) and keep the values of the enum as IDs; further classes get
+   the next free ID when they are first registered. The TtEvent stores its hypotheses
+   in vectors indexed by these IDs, so new reconstruction algorithms do not need a new
+   enum value. IDs should be registered once per module (e.g. in the constructor) and
+   kept; the table of the job should be stored as run product (see table()).
+
+   All methods are static and safe for concurrent use. Lookups do not lock: they read an
+   immutable snapshot of the registry, which is replaced by a new one when a class is
+   registered. Replaced snapshots are kept until the end of the job, as concurrent
+   lookups may still read them; their number is bounded by the number of registrations.
+*/
+
+class TtHypoClassRegistry {
+
+ public:
+  /// return the ID of the hypothesis class 'name'; it is registered if not yet known
+  static unsigned int registerHypoClass(const std::string& name);
+  /// return the ID of the hypothesis class 'name'; -1 if it is not registered
+  static int find(const std::string& name);
+  /// return the ID of the hypothesis class 'name'; throws if it is not registered
+  static unsigned int id(const std::string& name);
+  /// return the name of the hypothesis class with the given ID; throws if not registered
+  static std::string name(const unsigned int id);
+  /// return the number of registered hypothesis classes
+  static unsigned int size();
+  /// return the names of all registered hypothesis classes, indexed by their ID
+  static TtHypoClassTable table();
+  /// register all hypothesis classes of a table read from file and return the ID of
+  /// this job for each ID of the table; the events and summaries of the file are
+  /// translated with it by their remapHypoClasses methods
+  static std::vector<unsigned int> import(const TtHypoClassTable& table);
+
+ private:
+  /// not to be instantiated
+  TtHypoClassRegistry();
+
+  /// immutable state of the registry: names of the registered classes, indexed by their
+  /// ID, and IDs of the registered classes by name
+  struct Snapshot {
+    std::vector<std::string> names;
+    std::map<std::string, unsigned int> ids;
+  };
+
+  /// lock and unlock the registry (only needed to register classes)
+  static void lock();
+  static void unlock();
+  /// pointer to the current snapshot (0 before the first use)
+  static const Snapshot*& current();
+  /// return the current snapshot without locking; the first call publishes the built-in classes
+  static const Snapshot& snapshot();
+  /// register 'name' in a copy of the current snapshot
+  static unsigned int add(Snapshot& snapshot, const std::string& name);
+  /// replace the current snapshot; needs the lock
+  static void publish(const Snapshot* snapshot);
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef TopObjects_TtHypoClassTable_h
+#define TopObjects_TtHypoClassTable_h
+
+#include <string>
+#include <vector>
+
+/**
+   \class   TtHypoClassTable TtHypoClassTable.h "AnalysisDataFormats/TopObjects/interface/TtHypoClassTable.h"
+
+   \brief   Names of the hypothesis classes of a job, indexed by their integer ID
+
+   Snapshot of the TtHypoClassRegistry to be stored as run product next to the TtEvents,
+   so that the IDs of hypothesis classes that were registered at runtime can be mapped
+   back to their names (and to the IDs of a later job) when the file is read.
+*/
+
+class TtHypoClassTable {
+
+ public:
+  /// empty table
+  TtHypoClassTable() {};
+  /// table of the given names; the position of a name is its ID
+  explicit TtHypoClassTable(const std::vector<std::string>& names) : names_(names) {};
+
+  /// number of hypothesis classes
+  unsigned int size() const { return names_.size(); };
+  /// name of the hypothesis class with the given ID
+  const std::string& name(const unsigned int id) const { return names_[id]; };
+  /// names of all hypothesis classes, indexed by their ID
+  const std::vector<std::string>& names() const { return names_; };
+  /// ID of the hypothesis class with the given name; -1 if not in the table
+  int id(const std::string& name) const;
+  /// check whether the table is a prefix of 'other' or the other way round, i.e.
+  /// whether the IDs of both tables are compatible
+  bool isCompatible(const TtHypoClassTable& other) const;
+  /// needed to store the table as run product; the longer of two compatible tables is kept
+  bool mergeProduct(const TtHypoClassTable& other);
+
+ private:
+  /// names of the hypothesis classes, indexed by their ID
+  std::vector<std::string> names_;
+};
+
+#endif
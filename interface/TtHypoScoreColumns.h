@@ -0,0 +1,136 @@
+#ifndef TopObjects_TtHypoScoreColumns_h
+#define TopObjects_TtHypoScoreColumns_h
+
+#include <string>
+#include <vector>
+
+#include "AnalysisDataFormats/TopObjects/interface/TopCacheFlag.h"
+
+/**
+   \class   TtHypoScoreColumns TtHypoScoreColumns.h "AnalysisDataFormats/TopObjects/interface/TtHypoScoreColumns.h"
+
+   \brief   Named, typed columns of per-hypothesis scores of the TtEvent
+
+   Each column is attached to a hypothesis class (by its HypoClassId) and holds one value
+   per hypothesis of that class. The values of a column are kept contiguous in a vector of
+   their type (double, float or int). Columns are found in constant time by the job-wide
+   ID of their score (see TtHypoScoreRegistry) and accessed by their index afterwards; the
+   index of a column does not change when further columns are added. The index of the
+   columns by the IDs of their scores is transient and built on the first lookup; scores
+   not registered in the job are not indexed, reading a file does not register them.
+*/
+
+class TtHypoScoreColumns {
+
+ public:
+  /// supported types of the values
+  enum ValueType {kDouble, kFloat, kInt};
+
+  /// empty constructor
+  TtHypoScoreColumns(){};
+
+  /// number of columns
+  unsigned int size() const { return names_.size(); };
+  /// name of a column
+  const std::string& name(const unsigned int column) const { return names_[column]; };
+  /// ID of the hypothesis class a column is attached to
+  unsigned int hypoClass(const unsigned int column) const { return hypoClasses_[column]; };
+  /// type of the values of a column
+  ValueType valueType(const unsigned int column) const { return (ValueType)types_[column]; };
+  /// return the index of column 'name' of hypothesis class 'hypoClass'; -1 if not available
+  int find(const unsigned int hypoClass, const std::string& name) const;
+  /// return the index of the column of the score with the given ID (see TtHypoScoreRegistry);
+  /// -1 if not available
+  int column(const unsigned int id) const;
+  /// return the index of column 'name' of hypothesis class 'hypoClass', which is added if not
+  /// yet available; throws if the column is available with another type of values
+  unsigned int add(const unsigned int hypoClass, const std::string& name, const ValueType type);
+  /// same as above for the score with the given ID (see TtHypoScoreRegistry)
+  unsigned int add(const unsigned int id, const ValueType type);
+
+  /// values of a column with values of type T (the type is not checked)
+  template <typename T> const std::vector<T>& values(const unsigned int column) const { return storage((const T*)0)[slots_[column]]; };
+  template <typename T> std::vector<T>& values(const unsigned int column) { return storage((const T*)0)[slots_[column]]; };
+  /// number of values of a column
+  unsigned int numberOfValues(const unsigned int column) const;
+  /// value 'row' of a column converted to double; 'noValue' if not available
+  double value(const unsigned int column, const unsigned int row, const double noValue=-1.) const;
+
+  /// empty values of type T
+  static const std::vector<double>& noValues(const double*);
+  static const std::vector<float>& noValues(const float*);
+  static const std::vector<int>& noValues(const int*);
+  /// type of values T
+  static ValueType typeOf(const double*) { return kDouble; };
+  static ValueType typeOf(const float*) { return kFloat; };
+  static ValueType typeOf(const int*) { return kInt; };
+
+  /// translate the hypothesis classes of all columns: entry i of 'translation' is the new
+  /// ID of class i (see TtEvent::remapHypoClasses); classes it does not cover are kept
+  void remapHypoClasses(const std::vector<unsigned int>& translation);
+
+  /// remove all columns
+  void clear();
+  /// exchange the columns with 'other'
+  void swap(TtHypoScoreColumns& other);
+
+ private:
+  /// fill the index of the columns by the IDs of their scores; columns of scores that
+  /// are not registered are skipped
+  void buildIndex() const;
+  /// mark the index to be rebuilt on the next lookup
+  void resetIndex() { index_.clear(); indexFlag_.reset(); };
+
+  /// storage of the columns of a type of values
+  std::vector<std::vector<double> >& storage(const double*) { return doubles_; };
+  std::vector<std::vector<float> >& storage(const float*) { return floats_; };
+  std::vector<std::vector<int> >& storage(const int*) { return ints_; };
+  const std::vector<std::vector<double> >& storage(const double*) const { return doubles_; };
+  const std::vector<std::vector<float> >& storage(const float*) const { return floats_; };
+  const std::vector<std::vector<int> >& storage(const int*) const { return ints_; };
+
+  /// names, hypothesis classes and types of values of the columns
+  std::vector<std::string> names_;
+  std::vector<unsigned int> hypoClasses_;
+  std::vector<unsigned char> types_;
+  /// index of each column in the storage of its type
+  std::vector<unsigned int> slots_;
+  /// values of the columns by type
+  std::vector<std::vector<double> > doubles_;
+  std::vector<std::vector<float> > floats_;
+  std::vector<std::vector<int> > ints_;
+  /// index of the column of each score by its ID, covering the scores registered when
+  /// it was built (transient)
+  mutable std::vector<int> index_;
+  TopCacheFlag indexFlag_;
+};
+
+/**
+   \class   TtScoreHandle TtHypoScoreColumns.h "AnalysisDataFormats/TopObjects/interface/TtHypoScoreColumns.h"
+
+   \brief   Resolved score of the TtEvent with values of type T
+
+   Holds the job-wide ID of the score (see TtHypoScoreRegistry). Obtained from
+   TtEvent::scoreHandle or TtEvent::addScore and valid for all events of the job; whether
+   the score is available in a given event is checked by TtEvent::isScoreAvailable.
+*/
+
+template <typename T>
+class TtScoreHandle {
+
+ public:
+  /// invalid handle
+  TtScoreHandle() : id_(-1) {};
+  /// handle of the score with the given ID; -1 for an invalid handle
+  explicit TtScoreHandle(const int id) : id_(id) {};
+
+  /// check if the handle was resolved
+  bool isValid() const { return id_>=0; };
+  /// ID of the score (see TtHypoScoreRegistry)
+  int id() const { return id_; };
+
+ private:
+  int id_;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef TopObjects_TtHypoScoreRegistry_h
+#define TopObjects_TtHypoScoreRegistry_h
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+   \class   TtHypoScoreRegistry TtHypoScoreRegistry.h "AnalysisDataFormats/TopObjects/interface/TtHypoScoreRegistry.h"
+
+   \brief   Job-wide registry of the per-hypothesis scores of the TtEvent
+
+   Assigns dense integer IDs to the scores, identified by the ID of their hypothesis class
+   and their name. The built-in scores are registered from the start and keep the values
+   of TtEvent::HypoScoreKey as IDs; further scores get the next free ID when they are first
+   registered. The TtHypoScoreColumns of each event index their columns by these IDs, such
+   that a score resolved once per job (see TtEvent::scoreHandle) is found in every event
+   in constant time.
+
+   All methods are static and safe for concurrent use. As in the TtHypoClassRegistry,
+   lookups read an immutable snapshot without locking; registering a score publishes
+   an extended copy.
+*/
+
+class TtHypoScoreRegistry {
+
+ public:
+  /// return the ID of score 'name' of hypothesis class 'hypoClass'; it is registered if not yet known
+  static unsigned int registerScore(const unsigned int hypoClass, const std::string& name);
+  /// return the ID of score 'name' of hypothesis class 'hypoClass'; -1 if it is not registered
+  static int find(const unsigned int hypoClass, const std::string& name);
+  /// return the hypothesis class and the name of the score with the given ID; throws if not registered
+  static void score(const unsigned int id, unsigned int& hypoClass, std::string& name);
+  /// return the number of registered scores
+  static unsigned int size();
+
+ private:
+  /// not to be instantiated
+  TtHypoScoreRegistry();
+
+  /// immutable state of the registry: hypothesis classes and names of the registered
+  /// scores, indexed by their ID, and IDs of the registered scores by class and name
+  struct Snapshot {
+    std::vector<std::pair<unsigned int, std::string> > scores;
+    std::map<std::pair<unsigned int, std::string>, unsigned int> ids;
+  };
+
+  /// lock and unlock the registry (only needed to register scores)
+  static void lock();
+  static void unlock();
+  /// pointer to the current snapshot (0 before the first use)
+  static const Snapshot*& current();
+  /// return the current snapshot without locking; the first call publishes the built-in scores
+  static const Snapshot& snapshot();
+  /// replace the current snapshot; needs the lock
+  static void publish(const Snapshot* snapshot);
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef TopObjects_TtJetLepComb_h
+#define TopObjects_TtJetLepComb_h
+
+#include <vector>
+
+/**
+   \class   TtJetLepCombView TtJetLepComb.h "AnalysisDataFormats/TopObjects/interface/TtJetLepComb.h"
+
+   \brief   Non-owning view of the jet lepton combination of a single event hypothesis
+
+   The view points into the packed TtJetLepCombBuffer of a hypothesis class and is
+   valid as long as the buffer (i.e. the TtEvent) is not modified. Comparing views
+   or copying them does not allocate any memory.
+*/
+
+class TtJetLepCombView {
+
+ public:
+  /// empty view
+  TtJetLepCombView() : begin_(0), end_(0) {};
+  /// view of the indices in [begin, end)
+  TtJetLepCombView(const short* begin, const short* end) : begin_(begin), end_(end) {};
+
+  /// number of indices
+  unsigned int size() const { return end_-begin_; };
+  /// check whether the combination is empty
+  bool empty() const { return begin_==end_; };
+  /// index 'i' of the combination
+  int operator[](const unsigned int i) const { return begin_[i]; };
+  /// iterators over the indices
+  const short* begin() const { return begin_; };
+  const short* end() const { return end_; };
+  /// copy the indices into a vector of int
+  std::vector<int> vector() const { return std::vector<int>(begin_, end_); };
+
+  /// compare two combinations index by index
+  bool operator==(const TtJetLepCombView& rhs) const;
+  bool operator!=(const TtJetLepCombView& rhs) const { return !(*this==rhs); };
+  /// compare to a combination given as vector of int
+  bool operator==(const std::vector<int>& rhs) const;
+  bool operator!=(const std::vector<int>& rhs) const { return !(*this==rhs); };
+
+ private:
+  const short* begin_;
+  const short* end_;
+};
+
+/**
+   \class   TtJetLepCombBuffer TtJetLepComb.h "AnalysisDataFormats/TopObjects/interface/TtJetLepComb.h"
+
+   \brief   Packed storage of the jet lepton combinations of all hypotheses of one class
+
+   The indices of all hypotheses are kept one after the other in a single vector of
+   short integers; for each hypothesis the end of its combination in this vector is
+   recorded. This replaces one heap allocated std::vector<int> per hypothesis.
+*/
+
+class TtJetLepCombBuffer {
+
+ public:
+  /// empty buffer
+  TtJetLepCombBuffer() {};
+
+  /// number of combinations
+  unsigned int size() const { return ends_.size(); };
+  /// view of combination 'i'
+  TtJetLepCombView operator[](const unsigned int i) const;
+  /// append a combination; throws if an index is out of the range of short
+  void push_back(const std::vector<int>& comb);
+  /// reserve memory for 'n' combinations of 'nIndices' indices each
+  void reserve(const unsigned int n, const unsigned int nIndices=6) { ends_.reserve(n); indices_.reserve(n*nIndices); };
+  /// remove all combinations
+  void clear() { ends_.clear(); indices_.clear(); };
+  /// exchange the content with 'other' without copying
+  void swap(TtJetLepCombBuffer& other) { ends_.swap(other.ends_); indices_.swap(other.indices_); };
+
+ private:
+  /// indices of all combinations, one after the other
+  std::vector<short> indices_;
+  /// end of each combination in indices_
+  std::vector<unsigned int> ends_;
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef TtNeutrinoSolver_h
+#define TtNeutrinoSolver_h
+
+#include <vector>
+
+#include "DataFormats/Math/interface/LorentzVector.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtSemiLeptonicEvent.h"
+
+/**
+   \class   TtNeutrinoSolver TtNeutrinoSolver.h "AnalysisDataFormats/TopObjects/interface/TtNeutrinoSolver.h"
+
+   \brief   Batch solver for the longitudinal neutrino momentum from the W mass constraint
+
+   For every pair of lepton and MET candidates the neutrino is taken to be massless with
+   the transverse momentum of the MET, and its pz is fixed by requiring the invariant mass
+   of lepton and neutrino to be the W mass. This gives a quadratic equation with 2, 1 or
+   0 real solutions. Of two real solutions the one with the smaller |pz| is chosen. In
+   case of complex solutions the policy decides:
+
+    - kRealPart   : use the real part of the complex solutions
+    - kRescaleMET : scale the MET down to the largest value that gives a real (double)
+                    solution and use this solution
+    - kNoSolution : flag the pair as without solution
+
+   Pairs are collected with add() and solved together with solve(), which runs over
+   contiguous arrays of the input components.
+*/
+
+class TtNeutrinoSolver {
+
+ public:
+  /// policies for complex solutions
+  enum ComplexPolicy { kRealPart, kRescaleMET, kNoSolution };
+
+ public:
+  /// default constructor
+  TtNeutrinoSolver(const ComplexPolicy policy=kRealPart, const double wMass=80.4) : policy_(policy), wMass_(wMass) {};
+  /// default destructor
+  ~TtNeutrinoSolver(){};
+
+  /// remove all pairs
+  void clear();
+  /// reserve memory for n pairs
+  void reserve(const unsigned int n);
+  /// add a pair of lepton and MET candidates; returns its index
+  unsigned int add(const math::XYZTLorentzVector& lepton, const math::XYZTLorentzVector& met);
+  /// solve all pairs added so far
+  void solve();
+
+  /// number of pairs
+  unsigned int size() const { return lepE_.size(); };
+  /// number of real solutions of pair i (2, 1 or 0)
+  int numberOfRealSolutions(const unsigned int i) const { return nReal_[i]; };
+  /// check if the chosen solution of pair i is valid (false only for the policy kNoSolution)
+  bool isValid(const unsigned int i) const { return nReal_[i]>0 || policy_!=kNoSolution; };
+  /// pz of the chosen solution (solution=0) or of the other solution (solution=1) of pair i
+  double pz(const unsigned int i, const unsigned int solution=0) const { return solution==0 ? pz_[i] : pzOther_[i]; };
+  /// neutrino four-vector of the chosen solution (solution=0) or of the other solution (solution=1)
+  /// of pair i; the transverse momentum differs from the MET for the policy kRescaleMET
+  math::XYZTLorentzVector neutrino(const unsigned int i, const unsigned int solution=0) const;
+  /// set the number of real solutions of pair i for hypothesis class 'key' of 'evt'
+  void fillNumberOfRealSolutions(TtSemiLeptonicEvent& evt, const TtEvent::HypoClassId& key, const unsigned int i=0) const
+    { evt.setNumberOfRealNeutrinoSolutions(key, numberOfRealSolutions(i)); };
+
+ private:
+  /// policy for complex solutions and W mass
+  ComplexPolicy policy_;
+  double wMass_;
+  /// inputs (structure of arrays)
+  std::vector<double> lepPx_, lepPy_, lepPz_, lepE_;
+  std::vector<double> nuPx_, nuPy_;
+  /// results; scale factors of the MET (for the policy kRescaleMET)
+  std::vector<double> pz_, pzOther_, scale_;
+  std::vector<int> nReal_;
+};
+
+#endif
@@ -15,6 +15,7 @@
 #include "DataFormats/Candidate/interface/Particle.h"
 #include "DataFormats/HepMCCandidate/interface/GenParticle.h"
 #include "AnalysisDataFormats/TopObjects/interface/TtGenEvent.h"
+#include "AnalysisDataFormats/TopObjects/interface/TopRefProdCache.h"
 
 #include "DataFormats/PatCandidates/interface/Particle.h"
 #include "DataFormats/PatCandidates/interface/Electron.h"
@@ -26,7 +27,6 @@
 #include "DataFormats/Candidate/interface/ShallowClonePtrCandidate.h"
 #include "DataFormats/Candidate/interface/CompositeCandidate.h"
 
-// FIXME: make the decay member an enumerable
 // FIXME: Can we generalize all the muon and electron to lepton?
 
 class TtSemiEvtSolution {
@@ -60,16 +60,16 @@ class TtSemiEvtSolution {
   // get the matched gen particles
   //-------------------------------------------
   const edm::RefProd<TtGenEvent> & getGenEvent() const { return theGenEvt_; };
-  const reco::GenParticle * getGenHadt() const { if (!theGenEvt_) return 0; else return this->getGenEvent()->hadronicDecayTop(); };
-  const reco::GenParticle * getGenHadW() const { if (!theGenEvt_) return 0; else return this->getGenEvent()->hadronicDecayW(); };
-  const reco::GenParticle * getGenHadb() const { if (!theGenEvt_) return 0; else return this->getGenEvent()->hadronicDecayB(); };
-  const reco::GenParticle * getGenHadp() const { if (!theGenEvt_) return 0; else return this->getGenEvent()->hadronicDecayQuark(); };
-  const reco::GenParticle * getGenHadq() const { if (!theGenEvt_) return 0; else return this->getGenEvent()->hadronicDecayQuarkBar(); };
-  const reco::GenParticle * getGenLept() const { if (!theGenEvt_) return 0; else return this->getGenEvent()->leptonicDecayTop(); };
-  const reco::GenParticle * getGenLepW() const { if (!theGenEvt_) return 0; else return this->getGenEvent()->leptonicDecayW(); };
-  const reco::GenParticle * getGenLepb() const { if (!theGenEvt_) return 0; else return this->getGenEvent()->leptonicDecayB(); };
-  const reco::GenParticle * getGenLepl() const { if (!theGenEvt_) return 0; else return this->getGenEvent()->singleLepton(); };
-  const reco::GenParticle * getGenLepn() const { if (!theGenEvt_) return 0; else return this->getGenEvent()->singleNeutrino(); };
+  const reco::GenParticle * getGenHadt() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->hadronicDecayTop(); };
+  const reco::GenParticle * getGenHadW() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->hadronicDecayW(); };
+  const reco::GenParticle * getGenHadb() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->hadronicDecayB(); };
+  const reco::GenParticle * getGenHadp() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->hadronicDecayQuark(); };
+  const reco::GenParticle * getGenHadq() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->hadronicDecayQuarkBar(); };
+  const reco::GenParticle * getGenLept() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->leptonicDecayTop(); };
+  const reco::GenParticle * getGenLepW() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->leptonicDecayW(); };
+  const reco::GenParticle * getGenLepb() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->leptonicDecayB(); };
+  const reco::GenParticle * getGenLepl() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->singleLepton(); };
+  const reco::GenParticle * getGenLepn() const { if (!theGenEvt_) return 0; else return theGenEvtCache_.get(theGenEvt_)->singleNeutrino(); };
 
   //-------------------------------------------
   // get (un-)/calibrated reco objects
@@ -116,7 +116,23 @@ class TtSemiEvtSolution {
   //-------------------------------------------
   // get the selected semileptonic decay chain 
   //-------------------------------------------
-  std::string getDecay() const { return decay_; }
+  std::string getDecay() const { return WDecay::leptonName(lepType_); }
+  WDecay::LeptonType getLeptonType() const { return lepType_; }
+
+  //-------------------------------------------
+  // get four-vectors of the composites without 
+  // copying pat::Jets or creating reco::Particles
+  //-------------------------------------------
+  enum P4Level { kRec, kCal, kFit };
+  struct CompositeP4 {
+    math::XYZTLorentzVector hadt, hadW, lept, lepW;
+  };
+  math::XYZTLorentzVector getHadtP4(P4Level level) const;
+  math::XYZTLorentzVector getHadWP4(P4Level level) const;
+  math::XYZTLorentzVector getLeptP4(P4Level level) const;
+  math::XYZTLorentzVector getLepWP4(P4Level level) const;
+  // all composites in one call
+  void getCompositeP4(CompositeP4& p4, P4Level level) const;
 
   //-------------------------------------------
   // get info on the matching
@@ -190,9 +206,9 @@ class TtSemiEvtSolution {
   void setLepb(const edm::Handle<std::vector<pat::Jet> > & jet, int i)
   { lepb_ = edm::Ptr<pat::Jet>(jet, i); };
   void setMuon(const edm::Handle<std::vector<pat::Muon> > & muon, int i)
-  { muon_ = edm::Ptr<pat::Muon>(muon, i); decay_ = "muon"; };
+  { muon_ = edm::Ptr<pat::Muon>(muon, i); lepType_ = WDecay::kMuon; };
   void setElectron(const edm::Handle<std::vector<pat::Electron> > & elec, int i)
-  { electron_ = edm::Ptr<pat::Electron>(elec, i); decay_ = "electron"; };
+  { electron_ = edm::Ptr<pat::Electron>(elec, i); lepType_ = WDecay::kElec; };
   void setNeutrino(const edm::Handle<std::vector<pat::MET> > & met, int i)
   { neutrino_ = edm::Ptr<pat::MET>(met, i); };
 
@@ -252,10 +268,20 @@ class TtSemiEvtSolution {
 
  private:
 
+  //-------------------------------------------
+  // four-vector of a single jet on a given level
+  //-------------------------------------------
+  math::XYZTLorentzVector getJetP4(const edm::Ptr<pat::Jet>& jet, const std::vector<pat::Particle>& fit,
+				   const char* flavor, P4Level level) const;
+  math::XYZTLorentzVector getFitP4(const std::vector<pat::Particle>& fit) const
+  { return fit.empty() ? math::XYZTLorentzVector() : math::XYZTLorentzVector(fit.front().p4()); };
+
   //-------------------------------------------    
   // particle content
   //-------------------------------------------  
   edm::RefProd<TtGenEvent> theGenEvt_;
+  /// resolved product of theGenEvt_ (transient)
+  TopRefProdCache<TtGenEvent> theGenEvtCache_;
   edm::Ptr<pat::Jet> hadb_, hadp_, hadq_, lepb_;
   edm::Ptr<pat::Muon> muon_;
   edm::Ptr<pat::Electron> electron_;
@@ -269,7 +295,7 @@ class TtSemiEvtSolution {
 
   void setupHyp();
 
-  std::string decay_;
+  WDecay::LeptonType lepType_;
   int jetCorrScheme_;
   double sumAnglejp_, angleHadp_, angleHadq_, angleHadb_, angleLepb_;
   int changeWQ_;
@@ -33,81 +33,91 @@ class TtSemiLeptonicEvent: public TtEvent {
   /// get hadronic top of the given hypothesis
   const reco::Candidate* hadronicDecayTop(const std::string& key, const unsigned& cmb=0) const { return hadronicDecayTop(hypoClassKeyFromString(key), cmb); };
   /// get hadronic top of the given hypothesis
-  const reco::Candidate* hadronicDecayTop(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : eventHypo(key,cmb). daughter(TtSemiLepDaughter::HadTop); };
+  const reco::Candidate* hadronicDecayTop(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : eventHypo(key,cmb). daughter(TtSemiLepDaughter::HadTop); };
   /// get hadronic b of the given hypothesis
   const reco::Candidate* hadronicDecayB(const std::string& key, const unsigned& cmb=0) const { return hadronicDecayB(hypoClassKeyFromString(key), cmb); };
   /// get hadronic b of the given hypothesis
-  const reco::Candidate* hadronicDecayB(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : hadronicDecayTop(key,cmb)->daughter(TtSemiLepDaughter::HadB); };
+  const reco::Candidate* hadronicDecayB(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : hadronicDecayTop(key,cmb)->daughter(TtSemiLepDaughter::HadB); };
   /// get hadronic W of the given hypothesis
   const reco::Candidate* hadronicDecayW(const std::string& key, const unsigned& cmb=0) const { return hadronicDecayW(hypoClassKeyFromString(key), cmb); };
   /// get hadronic W of the given hypothesis
-  const reco::Candidate* hadronicDecayW(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : hadronicDecayTop(key,cmb)->daughter(TtSemiLepDaughter::HadW); };
+  const reco::Candidate* hadronicDecayW(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : hadronicDecayTop(key,cmb)->daughter(TtSemiLepDaughter::HadW); };
   /// get hadronic light quark of the given hypothesis
   const reco::Candidate* hadronicDecayQuark(const std::string& key, const unsigned& cmb=0) const { return hadronicDecayQuark(hypoClassKeyFromString(key), cmb); };
   /// get hadronic light quark of the given hypothesis
-  const reco::Candidate* hadronicDecayQuark(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : hadronicDecayW(key,cmb)->daughter(TtSemiLepDaughter::HadP); };
+  const reco::Candidate* hadronicDecayQuark(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : hadronicDecayW(key,cmb)->daughter(TtSemiLepDaughter::HadP); };
   /// get hadronic light quark of the given hypothesis
   const reco::Candidate* hadronicDecayQuarkBar(const std::string& key, const unsigned& cmb=0) const { return hadronicDecayQuarkBar(hypoClassKeyFromString(key), cmb); };
   /// get hadronic light quark of the given hypothesis
-  const reco::Candidate* hadronicDecayQuarkBar(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : hadronicDecayW(key,cmb)->daughter(TtSemiLepDaughter::HadQ); };
+  const reco::Candidate* hadronicDecayQuarkBar(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : hadronicDecayW(key,cmb)->daughter(TtSemiLepDaughter::HadQ); };
   /// get leptonic top of the given hypothesis
   const reco::Candidate* leptonicDecayTop(const std::string& key, const unsigned& cmb=0) const { return leptonicDecayTop(hypoClassKeyFromString(key), cmb); };
   /// get leptonic top of the given hypothesis
-  const reco::Candidate* leptonicDecayTop(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : eventHypo(key,cmb). daughter(TtSemiLepDaughter::LepTop); };
+  const reco::Candidate* leptonicDecayTop(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : eventHypo(key,cmb). daughter(TtSemiLepDaughter::LepTop); };
   /// get leptonic b of the given hypothesis
   const reco::Candidate* leptonicDecayB(const std::string& key, const unsigned& cmb=0) const { return leptonicDecayB(hypoClassKeyFromString(key), cmb); };
   /// get leptonic b of the given hypothesis
-  const reco::Candidate* leptonicDecayB(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : leptonicDecayTop(key,cmb)->daughter(TtSemiLepDaughter::LepB); };
+  const reco::Candidate* leptonicDecayB(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : leptonicDecayTop(key,cmb)->daughter(TtSemiLepDaughter::LepB); };
   /// get leptonic W of the given hypothesis
   const reco::Candidate* leptonicDecayW(const std::string& key, const unsigned& cmb=0) const { return leptonicDecayW(hypoClassKeyFromString(key), cmb); };
   /// get leptonic W of the given hypothesis
-  const reco::Candidate* leptonicDecayW(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : leptonicDecayTop(key,cmb)->daughter(TtSemiLepDaughter::LepW); };
+  const reco::Candidate* leptonicDecayW(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : leptonicDecayTop(key,cmb)->daughter(TtSemiLepDaughter::LepW); };
   /// get leptonic light quark of the given hypothesis
   const reco::Candidate* singleNeutrino(const std::string& key, const unsigned& cmb=0) const { return singleNeutrino(hypoClassKeyFromString(key), cmb); };
   /// get leptonic light quark of the given hypothesis
-  const reco::Candidate* singleNeutrino(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : leptonicDecayW(key,cmb)->daughter(TtSemiLepDaughter::Nu); };
+  const reco::Candidate* singleNeutrino(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : leptonicDecayW(key,cmb)->daughter(TtSemiLepDaughter::Nu); };
   /// get leptonic light quark of the given hypothesis
   const reco::Candidate* singleLepton(const std::string& key, const unsigned& cmb=0) const { return singleLepton(hypoClassKeyFromString(key), cmb); };
   /// get leptonic light quark of the given hypothesis
-  const reco::Candidate* singleLepton(const HypoClassKey& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : leptonicDecayW(key,cmb)->daughter(TtSemiLepDaughter::Lep); };
+  const reco::Candidate* singleLepton(const HypoClassId& key, const unsigned& cmb=0) const { return !isHypoValid(key,cmb) ? 0 : leptonicDecayW(key,cmb)->daughter(TtSemiLepDaughter::Lep); };
 
   /// get hadronic top of the TtGenEvent
-  const reco::GenParticle* hadronicDecayTop() const { return (!genEvt_ ? 0 : this->genEvent()->hadronicDecayTop()); };
+  const reco::GenParticle* hadronicDecayTop() const { return (!genEvt_ ? 0 : this->genEventProduct()->hadronicDecayTop()); };
   /// get hadronic b of the TtGenEvent
-  const reco::GenParticle* hadronicDecayB() const { return (!genEvt_ ? 0 : this->genEvent()->hadronicDecayB()); };
+  const reco::GenParticle* hadronicDecayB() const { return (!genEvt_ ? 0 : this->genEventProduct()->hadronicDecayB()); };
   /// get hadronic W of the TtGenEvent
-  const reco::GenParticle* hadronicDecayW() const { return (!genEvt_ ? 0 : this->genEvent()->hadronicDecayW()); };
+  const reco::GenParticle* hadronicDecayW() const { return (!genEvt_ ? 0 : this->genEventProduct()->hadronicDecayW()); };
   /// get hadronic light quark of the TtGenEvent
-  const reco::GenParticle* hadronicDecayQuark() const { return (!genEvt_ ? 0 : this->genEvent()->hadronicDecayQuark()); };
+  const reco::GenParticle* hadronicDecayQuark() const { return (!genEvt_ ? 0 : this->genEventProduct()->hadronicDecayQuark()); };
   /// get hadronic light quark of the TtGenEvent
-  const reco::GenParticle* hadronicDecayQuarkBar() const { return (!genEvt_ ? 0 : this->genEvent()->hadronicDecayQuarkBar()); };
+  const reco::GenParticle* hadronicDecayQuarkBar() const { return (!genEvt_ ? 0 : this->genEventProduct()->hadronicDecayQuarkBar()); };
   /// get leptonic top of the TtGenEvent
-  const reco::GenParticle* leptonicDecayTop() const { return (!genEvt_ ? 0 : this->genEvent()->leptonicDecayTop()); };
+  const reco::GenParticle* leptonicDecayTop() const { return (!genEvt_ ? 0 : this->genEventProduct()->leptonicDecayTop()); };
   /// get leptonic b of the TtGenEvent
-  const reco::GenParticle* leptonicDecayB() const { return (!genEvt_ ? 0 : this->genEvent()->leptonicDecayB()); };
+  const reco::GenParticle* leptonicDecayB() const { return (!genEvt_ ? 0 : this->genEventProduct()->leptonicDecayB()); };
   /// get leptonic W of the TtGenEvent
-  const reco::GenParticle* leptonicDecayW() const { return (!genEvt_ ? 0 : this->genEvent()->leptonicDecayW()); };
+  const reco::GenParticle* leptonicDecayW() const { return (!genEvt_ ? 0 : this->genEventProduct()->leptonicDecayW()); };
   /// get lepton top of the TtGenEvent
-  const reco::GenParticle* singleLepton() const { return (!genEvt_ ? 0 : this->genEvent()->singleLepton());   };
+  const reco::GenParticle* singleLepton() const { return (!genEvt_ ? 0 : this->genEventProduct()->singleLepton());   };
   /// get neutrino of the TtGenEvent
-  const reco::GenParticle* singleNeutrino() const { return (!genEvt_ ? 0 : this->genEvent()->singleNeutrino()); };
+  const reco::GenParticle* singleNeutrino() const { return (!genEvt_ ? 0 : this->genEventProduct()->singleNeutrino()); };
 
   /// print full content of the structure as formated 
   /// LogInfo to the MessageLogger output for debugging
   void print(const int verbosity=1) const;
+  /// format the full content of the structure into 'buffer' in a single pass; the
+  /// buffer is cleared but keeps its capacity, so that it can be reused from event
+  /// to event; if 'compact' is true a single JSON-like record is produced instead
+  void dump(std::string& buffer, const int verbosity=1, const bool compact=false) const;
 
   /// get number of real neutrino solutions for a given hypo class
-  const int numberOfRealNeutrinoSolutions(const HypoClassKey& key) const { return (numberOfRealNeutrinoSolutions_.find(key)==numberOfRealNeutrinoSolutions_.end() ? -999 : numberOfRealNeutrinoSolutions_.find(key)->second); };
+  const int numberOfRealNeutrinoSolutions(const HypoClassId& key) const { return (key<numberOfRealNeutrinoSolutions_.size() ? numberOfRealNeutrinoSolutions_[key] : -999); };
   /// get number of real neutrino solutions for a given hypo class
   const int numberOfRealNeutrinoSolutions(const std::string& key) const { return numberOfRealNeutrinoSolutions(hypoClassKeyFromString(key)); };
 
   /// set number of real neutrino solutions for a given hypo class
-  void setNumberOfRealNeutrinoSolutions(const HypoClassKey& key, const int& nr) { numberOfRealNeutrinoSolutions_[key] = nr; };
+  void setNumberOfRealNeutrinoSolutions(const HypoClassId& key, const int& nr) { if(numberOfRealNeutrinoSolutions_.size()<=key) numberOfRealNeutrinoSolutions_.resize(key+1, -999); numberOfRealNeutrinoSolutions_[key] = nr; };
+  /// translate the IDs of all hypothesis classes (see TtEvent::remapHypoClasses)
+  virtual void remapHypoClasses(const std::vector<unsigned int>& translation);
 
  protected:
 
-  /// number of real neutrino solutions for all hypo classes
-  std::map<HypoClassKey, int> numberOfRealNeutrinoSolutions_;
+  /// top, anti-top and the charged leptons of their decays for the kinematics of the ttbar system
+  virtual void systemCandidates(const reco::CompositeCandidate& hypo, const reco::Candidate*& top, const reco::Candidate*& topBar,
+				const reco::Candidate*& leptonBar, const reco::Candidate*& lepton) const;
+
+  /// number of real neutrino solutions, indexed by HypoClassId (-999 if not set)
+  std::vector<int> numberOfRealNeutrinoSolutions_;
 
 };
 
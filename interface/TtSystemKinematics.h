@@ -0,0 +1,53 @@
+#ifndef TopObjects_TtSystemKinematics_h
+#define TopObjects_TtSystemKinematics_h
+
+#include <vector>
+
+#include "DataFormats/Math/interface/LorentzVector.h"
+
+/**
+   \struct  TtSystemKinematics TtSystemKinematics.h "AnalysisDataFormats/TopObjects/interface/TtSystemKinematics.h"
+
+   \brief   Derived kinematics of a ttbar system
+
+   Kinematics of the ttbar system and the spin correlation angles in the helicity basis:
+   the direction k of the top quark in the ttbar rest frame is the reference axis; the
+   charged leptons (or any other spin analyzer) are taken in the rest frame of their top
+   quark, reached by boosting into the ttbar rest frame first. Angles that can not be
+   computed are set to -2, deltaPhiLeptons to -1.
+*/
+
+struct TtSystemKinematics {
+
+  /// empty constructor
+  TtSystemKinematics() : valid(false), mass(0.), rapidity(0.), pt(0.), cosThetaStar(-2.),
+    cosThetaLeptonBar(-2.), cosThetaLepton(-2.), cosPhi(-2.), deltaPhiLeptons(-1.) {};
+
+  /// compute from the four-vectors of top and anti-top and, if available, of the
+  /// anti-lepton of the top and the lepton of the anti-top decay
+  void compute(const math::XYZTLorentzVector& top, const math::XYZTLorentzVector& topBar,
+	       const math::XYZTLorentzVector* leptonBar=0, const math::XYZTLorentzVector* lepton=0);
+  /// compute for a batch of ttbar systems; 'leptonBars' and 'leptons' may be empty
+  static void compute(const std::vector<math::XYZTLorentzVector>& tops, const std::vector<math::XYZTLorentzVector>& topBars,
+		      const std::vector<math::XYZTLorentzVector>& leptonBars, const std::vector<math::XYZTLorentzVector>& leptons,
+		      std::vector<TtSystemKinematics>& result);
+
+  /// false if not computed
+  bool valid;
+  /// invariant mass, rapidity and transverse momentum of the ttbar system
+  double mass;
+  double rapidity;
+  double pt;
+  /// cosine of the angle between k and the beam axis
+  double cosThetaStar;
+  /// cosine of the angle between the anti-lepton in the top rest frame and k
+  double cosThetaLeptonBar;
+  /// cosine of the angle between the lepton in the anti-top rest frame and -k
+  double cosThetaLepton;
+  /// cosine of the opening angle of anti-lepton and lepton in the rest frames of their top quarks
+  double cosPhi;
+  /// azimuthal angle between anti-lepton and lepton in the laboratory frame
+  double deltaPhiLeptons;
+};
+
+#endif
@@ -0,0 +1,99 @@
+#include "FWCore/Utilities/interface/EDMException.h"
+#include "AnalysisDataFormats/TopObjects/interface/CATopJetFlatTagInfoCollection.h"
+
+using namespace reco;
+
+CATopJetFlatTagInfoCollection::CATopJetFlatTagInfoCollection(const edm::Handle<edm::View<Jet> >& jets) :
+  jets_(jets)
+{
+  resize(jets->size());
+}
+
+CATopJetFlatTagInfoCollection::CATopJetFlatTagInfoCollection(const edm::Handle<edm::View<Jet> >& jets, const CATopJetTagInfoCollection& tagInfos) :
+  jets_(jets)
+{
+  resize(jets->size());
+  set(tagInfos);
+}
+
+CATopJetProperties
+CATopJetFlatTagInfoCollection::properties(unsigned int i) const
+{
+  CATopJetProperties properties;
+  properties.nSubJets = nSubJets_[i] < 0 ? 0 : nSubJets_[i];
+  properties.minMass  = minMass_[i];
+  properties.topMass  = topMass_[i];
+  properties.wMass    = wMass_  [i];
+  properties.wMassRatio     = wMassRatio_    [i];
+  properties.m23OverM123    = m23OverM123_   [i];
+  properties.atanM13OverM12 = atanM13OverM12_[i];
+  properties.cosHelicity    = cosHelicity_   [i];
+  properties.pairMasses.assign(pairMasses_.begin()+pairMassOffsets_[i], pairMasses_.begin()+pairMassOffsets_[i+1]);
+  return properties;
+}
+
+void
+CATopJetFlatTagInfoCollection::set(unsigned int i, const CATopJetProperties& properties)
+{
+  nSubJets_[i] = properties.nSubJets;
+  minMass_ [i] = properties.minMass;
+  topMass_ [i] = properties.topMass;
+  wMass_   [i] = properties.wMass;
+  wMassRatio_    [i] = properties.wMassRatio;
+  m23OverM123_   [i] = properties.m23OverM123;
+  atanM13OverM12_[i] = properties.atanM13OverM12;
+  cosHelicity_   [i] = properties.cosHelicity;
+  // replace the pairwise masses of the jet and shift those of the following jets
+  const unsigned int begin = pairMassOffsets_[i], end = pairMassOffsets_[i+1];
+  const unsigned int n = properties.pairMasses.size();
+  if(n != end-begin) {
+    pairMasses_.erase(pairMasses_.begin()+begin, pairMasses_.begin()+end);
+    pairMasses_.insert(pairMasses_.begin()+begin, n, 0.);
+    for(unsigned int j=i+1; j<pairMassOffsets_.size(); ++j)
+      pairMassOffsets_[j] = pairMassOffsets_[j]-(end-begin)+n;
+  }
+  for(unsigned int k=0; k<n; ++k)
+    pairMasses_[begin+k] = properties.pairMasses[k];
+}
+
+void
+CATopJetFlatTagInfoCollection::set(const CATopJetTagInfoCollection& tagInfos)
+{
+  for(CATopJetTagInfoCollection::const_iterator tagInfo = tagInfos.begin(); tagInfo != tagInfos.end(); ++tagInfo) {
+    edm::RefToBase<Jet> jet = tagInfo->jet();
+    if(jet.id() != jets_.id() || jet.key() >= size())
+      throw edm::Exception( edm::errors::InvalidReference, "CATopJetTagInfo does not refer to the jet collection of the CATopJetFlatTagInfoCollection" );
+    set(jet.key(), tagInfo->properties());
+  }
+}
+
+void
+CATopJetFlatTagInfoCollection::fillTagInfos(const edm::Handle<edm::View<Jet> >& jets, CATopJetTagInfoCollection& tagInfos) const
+{
+  if(jets.id() != jets_.id() || jets->size() != size())
+    throw edm::Exception( edm::errors::InvalidReference, "jet collection is not parallel to the CATopJetFlatTagInfoCollection" );
+  tagInfos.reserve(tagInfos.size()+size());
+  for(unsigned int i=0; i<size(); ++i) {
+    if(!hasTagInfo(i))
+      continue;
+    CATopJetTagInfo tagInfo;
+    tagInfo.insert(jets->refAt(i), properties(i));
+    tagInfos.push_back(tagInfo);
+  }
+}
+
+void
+CATopJetFlatTagInfoCollection::resize(unsigned int nJets)
+{
+  nSubJets_.assign(nJets, -1);
+  minMass_ .assign(nJets, 0.);
+  topMass_ .assign(nJets, 0.);
+  wMass_   .assign(nJets, 0.);
+  // defaults of CATopJetProperties
+  wMassRatio_    .assign(nJets, -1.);
+  m23OverM123_   .assign(nJets, -1.);
+  atanM13OverM12_.assign(nJets, -1.);
+  cosHelicity_   .assign(nJets, -2.);
+  pairMasses_.clear();
+  pairMassOffsets_.assign(nJets+1, 0);
+}
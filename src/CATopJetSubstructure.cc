@@ -0,0 +1,202 @@
+#include "AnalysisDataFormats/TopObjects/interface/CATopJetSubstructure.h"
+#include <cmath>
+#include <algorithm>
+
+using namespace reco;
+
+const double CATopJetSubstructure::noMinMass = 999999.;
+const double CATopJetSubstructure::noWMass   = 99999.;
+
+namespace {
+  // signed invariant mass of a pair of subjets (negative for space-like sums)
+  inline double pairMass(double e, double px, double py, double pz)
+  {
+    double m2 = e*e - px*px - py*py - pz*pz;
+    return m2 < 0. ? -std::sqrt(-m2) : std::sqrt(m2);
+  }
+}
+
+unsigned int
+CATopJetSubjetBatch::addJet(const std::vector<math::XYZTLorentzVector>& subjets)
+{
+  math::XYZTLorentzVector sum;
+  for(unsigned int i=0; i<subjets.size(); ++i)
+    sum += subjets[i];
+  return addJet(subjets, sum.mass());
+}
+
+unsigned int
+CATopJetSubjetBatch::addJet(const std::vector<math::XYZTLorentzVector>& subjets, double jetMass)
+{
+  // select the leading subjets in pt (kept sorted by descending pt)
+  int lead[nLeadingSubJets];
+  double leadPt[nLeadingSubJets];
+  for(unsigned int r=0; r<nLeadingSubJets; ++r) {
+    lead[r] = -1; leadPt[r] = -1.;
+  }
+  for(unsigned int i=0; i<subjets.size(); ++i) {
+    double pt = subjets[i].pt();
+    for(unsigned int r=0; r<nLeadingSubJets; ++r) {
+      if(pt > leadPt[r]) {
+	for(unsigned int s=nLeadingSubJets-1; s>r; --s) {
+	  lead[s] = lead[s-1]; leadPt[s] = leadPt[s-1];
+	}
+	lead[r] = i; leadPt[r] = pt;
+	break;
+      }
+    }
+  }
+  for(unsigned int r=0; r<nLeadingSubJets; ++r) {
+    if(lead[r] < 0) {
+      px_[r].push_back(0.); py_[r].push_back(0.); pz_[r].push_back(0.); e_[r].push_back(0.);
+      continue;
+    }
+    const math::XYZTLorentzVector& p4 = subjets[lead[r]];
+    px_[r].push_back(p4.px()); py_[r].push_back(p4.py()); pz_[r].push_back(p4.pz()); e_[r].push_back(p4.energy());
+  }
+  nSubJets_.push_back(subjets.size());
+  jetMass_ .push_back(jetMass);
+  return nSubJets_.size()-1;
+}
+
+unsigned int
+CATopJetSubjetBatch::addJet(const Jet& jet)
+{
+  std::vector<math::XYZTLorentzVector> subjets;
+  subjets.reserve(jet.numberOfDaughters());
+  for(unsigned int i=0; i<jet.numberOfDaughters(); ++i)
+    subjets.push_back(jet.daughter(i)->p4());
+  return addJet(subjets, jet.mass());
+}
+
+void
+CATopJetSubjetBatch::reserve(unsigned int nJets)
+{
+  for(unsigned int r=0; r<nLeadingSubJets; ++r) {
+    px_[r].reserve(nJets); py_[r].reserve(nJets); pz_[r].reserve(nJets); e_[r].reserve(nJets);
+  }
+  nSubJets_.reserve(nJets);
+  jetMass_ .reserve(nJets);
+}
+
+void
+CATopJetSubjetBatch::clear()
+{
+  for(unsigned int r=0; r<nLeadingSubJets; ++r) {
+    px_[r].clear(); py_[r].clear(); pz_[r].clear(); e_[r].clear();
+  }
+  nSubJets_.clear();
+  jetMass_ .clear();
+}
+
+void
+CATopJetSubstructure::compute(const CATopJetSubjetBatch& batch, std::vector<double>& minMass, std::vector<double>& wMass) const
+{
+  const unsigned int n = batch.size();
+  minMass.resize(n);
+  wMass  .resize(n);
+  if(n==0)
+    return;
+  // plain pointers to the arrays of the batch; the loop below is free of
+  // branches, such that it can be vectorized over jets by the compiler
+  const double *px0 = &batch.px_[0][0], *py0 = &batch.py_[0][0], *pz0 = &batch.pz_[0][0], *e0 = &batch.e_[0][0];
+  const double *px1 = &batch.px_[1][0], *py1 = &batch.py_[1][0], *pz1 = &batch.pz_[1][0], *e1 = &batch.e_[1][0];
+  const double *px2 = &batch.px_[2][0], *py2 = &batch.py_[2][0], *pz2 = &batch.pz_[2][0], *e2 = &batch.e_[2][0];
+  double* minM = &minMass[0];
+  double* wM   = &wMass  [0];
+  const double mW = wMass_;
+  for(unsigned int i=0; i<n; ++i) {
+    double m01 = pairMass(e0[i]+e1[i], px0[i]+px1[i], py0[i]+py1[i], pz0[i]+pz1[i]);
+    double m02 = pairMass(e0[i]+e2[i], px0[i]+px2[i], py0[i]+py2[i], pz0[i]+pz2[i]);
+    double m12 = pairMass(e1[i]+e2[i], px1[i]+px2[i], py1[i]+py2[i], pz1[i]+pz2[i]);
+    // minimum mass pairing
+    double minA = std::fabs(m02) < std::fabs(m01) ? m02 : m01;
+    minM[i] = std::fabs(m12) < std::fabs(minA) ? m12 : minA;
+    // pairing closest to the W mass
+    double wA = std::fabs(m02-mW) < std::fabs(m01-mW) ? m02 : m01;
+    wM[i] = std::fabs(m12-mW) < std::fabs(wA-mW) ? m12 : wA;
+  }
+  // jets with less than three subjets cannot be paired
+  for(unsigned int i=0; i<n; ++i) {
+    if(batch.nSubJets_[i] < (int)CATopJetSubjetBatch::nLeadingSubJets) {
+      minM[i] = noMinMass;
+      wM  [i] = noWMass;
+    }
+  }
+}
+
+void
+CATopJetSubstructure::compute(const CATopJetSubjetBatch& batch, std::vector<CATopJetProperties>& properties) const
+{
+  std::vector<double> minMass, wMass;
+  compute(batch, minMass, wMass);
+  properties.resize(batch.size());
+  for(unsigned int i=0; i<batch.size(); ++i) {
+    properties[i].nSubJets = batch.nSubJets_[i];
+    properties[i].topMass  = batch.jetMass_ [i];
+    properties[i].minMass  = minMass[i];
+    properties[i].wMass    = wMass  [i];
+  }
+}
+
+namespace {
+  // order four-vectors by descending pt
+  bool greaterByPt(const math::XYZTLorentzVector& a, const math::XYZTLorentzVector& b) { return a.pt() > b.pt(); }
+
+  // boost 'p' into the rest frame of 'frame'
+  math::XYZTLorentzVector boostToRestFrame(const math::XYZTLorentzVector& p, const math::XYZTLorentzVector& frame)
+  {
+    double bx = -frame.px()/frame.energy(), by = -frame.py()/frame.energy(), bz = -frame.pz()/frame.energy();
+    double b2 = bx*bx + by*by + bz*bz;
+    if(b2 <= 0. || b2 >= 1.)
+      return p;
+    double gamma = 1./std::sqrt(1.-b2);
+    double bp = bx*p.px() + by*p.py() + bz*p.pz();
+    double gamma2 = (gamma-1.)/b2;
+    return math::XYZTLorentzVector(p.px() + gamma2*bp*bx + gamma*bx*p.energy(),
+				   p.py() + gamma2*bp*by + gamma*by*p.energy(),
+				   p.pz() + gamma2*bp*bz + gamma*bz*p.energy(),
+				   gamma*(p.energy() + bp));
+  }
+}
+
+void
+CATopJetSubstructure::computeObservables(const std::vector<math::XYZTLorentzVector>& subjets, CATopJetProperties& properties) const
+{
+  std::vector<math::XYZTLorentzVector> sorted(subjets);
+  std::sort(sorted.begin(), sorted.end(), greaterByPt);
+  const unsigned int n = sorted.size();
+  properties.nSubJets = n;
+  // pairwise mass matrix, upper triangle row by row
+  properties.pairMasses.clear();
+  properties.pairMasses.reserve(n*(n-1)/2);
+  for(unsigned int i=0; i<n; ++i)
+    for(unsigned int j=i+1; j<n; ++j)
+      properties.pairMasses.push_back((sorted[i]+sorted[j]).mass());
+  // derived observables need the three leading subjets
+  if(n < CATopJetSubjetBatch::nLeadingSubJets) {
+    properties.wMassRatio = properties.m23OverM123 = properties.atanM13OverM12 = -1.;
+    properties.cosHelicity = -2.;
+    return;
+  }
+  double m12 = properties.pairMass(0,1), m13 = properties.pairMass(0,2), m23 = properties.pairMass(1,2);
+  double m123 = (sorted[0]+sorted[1]+sorted[2]).mass();
+  properties.m23OverM123    = m123 > 0. ? m23/m123 : -1.;
+  properties.atanM13OverM12 = m12 > 0. ? std::atan(m13/m12) : -1.;
+  // W candidate is the pairing closest to the W mass, the remaining subjet is the b
+  // candidate; the helicity angle is the angle between the softer W daughter and the
+  // b candidate in the rest frame of the W candidate
+  unsigned int w1 = 0, w2 = 1, b = 2;
+  if(std::fabs(m13-wMass_) < std::fabs(m12-wMass_)) { w1 = 0; w2 = 2; b = 1; }
+  if(std::fabs(m23-wMass_) < std::fabs(properties.pairMass(w1,w2)-wMass_)) { w1 = 1; w2 = 2; b = 0; }
+  // the mass ratio is taken from the subjets only, independent of the other properties
+  math::XYZTLorentzVector all;
+  for(unsigned int i=0; i<n; ++i)
+    all += sorted[i];
+  properties.wMassRatio = all.mass() > 0. ? properties.pairMass(w1,w2)/all.mass() : -1.;
+  math::XYZTLorentzVector w = sorted[w1] + sorted[w2];
+  math::XYZTLorentzVector soft = boostToRestFrame(sorted[w2], w);
+  math::XYZTLorentzVector bRest = boostToRestFrame(sorted[b], w);
+  double norm = soft.P()*bRest.P();
+  properties.cosHelicity = norm > 0. ? (soft.px()*bRest.px() + soft.py()*bRest.py() + soft.pz()*bRest.pz())/norm : -2.;
+}
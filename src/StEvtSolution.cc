@@ -7,6 +7,7 @@
 
 StEvtSolution::StEvtSolution()
 {
+  lepType_        = WDecay::kNone;
   jetCorrScheme_  = 0;
   chi2Prob_       = -999.;
   pTrueCombExist_ = -999.;
@@ -64,19 +65,13 @@ pat::Jet StEvtSolution::getLight() const
 reco::Particle StEvtSolution::getLepW() const 
 {
   // FIXME: the charge from the genevent
-  reco::Particle p;
-  if(this->getDecay() == "muon") p=reco::Particle(0, this->getMuon().p4()+this->getNeutrino().p4(), math::XYZPoint());
-  if(this->getDecay() == "electron") p=reco::Particle(0, this->getElectron().p4()+this->getNeutrino().p4(), math::XYZPoint());
-  return p;
+  return reco::Particle(0, this->getLepWP4(kCal), math::XYZPoint());
 }
 
 reco::Particle StEvtSolution::getLept() const 
 {
   // FIXME: the charge from the genevent
-  reco::Particle p;
-  if(this->getDecay() == "muon") p=reco::Particle(0, this->getMuon().p4()+this->getNeutrino().p4()+this->getBottom().p4(), math::XYZPoint());
-  if(this->getDecay() == "electron") p=reco::Particle(0, this->getElectron().p4()+this->getNeutrino().p4()+this->getBottom().p4(), math::XYZPoint());
-  return p;
+  return reco::Particle(0, this->getLeptP4(kCal), math::XYZPoint());
 }
 
 //-------------------------------------------
@@ -86,7 +81,7 @@ reco::Particle StEvtSolution::getLept() const
 const reco::GenParticle * StEvtSolution::getGenBottom() const 
 { 
   if(!theGenEvt_) return 0; 
-  else return theGenEvt_->decayB();
+  else return theGenEvtCache_.get(theGenEvt_)->decayB();
 }
 
 // FIXME: not implemented yet
@@ -99,25 +94,25 @@ const reco::GenParticle * StEvtSolution::getGenBottom() const
 const reco::GenParticle * StEvtSolution::getGenLepton() const 
 { 
   if(!theGenEvt_) return 0; 
-  else return theGenEvt_->singleLepton(); 
+  else return theGenEvtCache_.get(theGenEvt_)->singleLepton(); 
 }
 
 const reco::GenParticle * StEvtSolution::getGenNeutrino() const 
 { 
   if(!theGenEvt_) return 0; 
-  else return theGenEvt_->singleNeutrino(); 
+  else return theGenEvtCache_.get(theGenEvt_)->singleNeutrino(); 
 }
 
 const reco::GenParticle * StEvtSolution::getGenLepW() const 
 { 
   if (!theGenEvt_) return 0; 
-  else return theGenEvt_->singleW(); 
+  else return theGenEvtCache_.get(theGenEvt_)->singleW(); 
 }
 
 const reco::GenParticle * StEvtSolution::getGenLept() const 
 { 
   if (!theGenEvt_) return 0; 
-  else return theGenEvt_->singleTop(); 
+  else return theGenEvtCache_.get(theGenEvt_)->singleTop(); 
 }
 
 //-------------------------------------------
@@ -126,10 +121,7 @@ const reco::GenParticle * StEvtSolution::getGenLept() const
 reco::Particle StEvtSolution::getRecLept() const 
 {
   // FIXME: the charge from the genevent
-  reco::Particle p;
-  if(this->getDecay() == "muon") p=reco::Particle(0, this->getMuon().p4()+this->getNeutrino().p4()+this->getRecBottom().p4(), math::XYZPoint());
-  if(this->getDecay() == "electron") p=reco::Particle(0, this->getElectron().p4()+this->getNeutrino().p4()+this->getRecBottom().p4(), math::XYZPoint());
-  return p;
+  return reco::Particle(0, this->getLeptP4(kRec), math::XYZPoint());
 }
 
 //-------------------------------------------
@@ -138,13 +130,57 @@ reco::Particle StEvtSolution::getRecLept() const
 reco::Particle StEvtSolution::getFitLepW() const 
 {
   // FIXME: provide the correct charge from generated event
-  return reco::Particle(0, this->getFitLepton().p4()+this->getFitNeutrino().p4());
+  return reco::Particle(0, this->getLepWP4(kFit));
 }
 
 reco::Particle StEvtSolution::getFitLept() const 
 { 
   // FIXME: provide the correct charge from generated event
-  return reco::Particle(0, this->getFitLepton().p4()+this->getFitNeutrino().p4()+this->getFitBottom().p4());
+  return reco::Particle(0, this->getLeptP4(kFit));
+}
+
+//-------------------------------------------
+// get four-vectors of the composites
+//-------------------------------------------
+math::XYZTLorentzVector StEvtSolution::getLepWP4(P4Level level) const
+{
+  if(level==kFit)
+    return getFitP4(fitLepton_) + getFitP4(fitNeutrino_);
+  switch(lepType_){
+  case WDecay::kMuon : return math::XYZTLorentzVector(muon_    ->p4()) + math::XYZTLorentzVector(neutrino_->p4());
+  case WDecay::kElec : return math::XYZTLorentzVector(electron_->p4()) + math::XYZTLorentzVector(neutrino_->p4());
+  default : return math::XYZTLorentzVector();
+  }
+}
+
+math::XYZTLorentzVector StEvtSolution::getLeptP4(P4Level level) const
+{
+  // an undefined decay channel yields an empty four-vector
+  if(level!=kFit && lepType_!=WDecay::kMuon && lepType_!=WDecay::kElec) return math::XYZTLorentzVector();
+  return getLepWP4(level) + getBottomP4(level);
+}
+
+void StEvtSolution::getCompositeP4(CompositeP4& p4, P4Level level) const
+{
+  // every jet and lepton is resolved only once
+  p4.lepW = getLepWP4(level);
+  p4.lept = (level!=kFit && lepType_!=WDecay::kMuon && lepType_!=WDecay::kElec) ? math::XYZTLorentzVector() : 
+    p4.lepW + getBottomP4(level);
+}
+
+math::XYZTLorentzVector StEvtSolution::getBottomP4(P4Level level) const
+{
+  switch(level){
+  case kRec : 
+    return bottom_->correctedP4("RAW");
+  case kCal : 
+    // WARNING the jet correction schemes are obsolete 
+    // and only kept for backwards compatibility
+    if(jetCorrScheme_==1 || jetCorrScheme_==2) return bottom_->correctedP4("HAD", "B");
+    return bottom_->p4();
+  default   : 
+    return getFitP4(fitBottom_);
+  }
 }
 
 //-------------------------------------------  
@@ -152,11 +188,12 @@ reco::Particle StEvtSolution::getFitLept() const
 //-------------------------------------------
 void StEvtSolution::setGenEvt(const edm::Handle<StGenEvent> & aGenEvt){
   theGenEvt_ = edm::RefProd<StGenEvent>(aGenEvt);
+  theGenEvtCache_.reset();
 }
 
 //-------------------------------------------
 // set other info on the event
 //-------------------------------------------
 void StEvtSolution::setScanValues(const std::vector<double> & val) {
-  for(unsigned int i=0; i<val.size(); i++) scanValues_.push_back(val[i]);
+  scanCurve_.set(0., 1., val);
 }
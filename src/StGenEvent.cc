@@ -24,98 +24,92 @@ StGenEvent::~StGenEvent()
 const reco::GenParticle* 
 StGenEvent::decayB() const 
 {
-  const reco::GenParticle* cand=0;
-  if (singleLepton()) {
-    const reco::GenParticleCollection & partsColl = *parts_;
-    const reco::GenParticle & singleLep = *singleLepton();
-    for (unsigned int i = 0; i < parts_->size(); ++i) {
-      if (std::abs(partsColl[i].pdgId())==TopDecayID::bID && 
-	  reco::flavour(singleLep)== - reco::flavour(partsColl[i])) { 
-	// ... but it should be the opposite!
-        cand = &partsColl[i];
-      }
-    }
-  }
-  return cand;
+  return role(kDecayB);
 }
 
 const reco::GenParticle* 
 StGenEvent::associatedB() const 
 {
-  const reco::GenParticle* cand=0;
-  if (singleLepton()) {
-    const reco::GenParticleCollection & partsColl = *parts_;
-    const reco::GenParticle & singleLep = *singleLepton();
-    for (unsigned int i = 0; i < parts_->size(); ++i) {
-      if (std::abs(partsColl[i].pdgId())==TopDecayID::bID && 
-	  reco::flavour(singleLep)== reco::flavour(partsColl[i])) { 
-	// ... but it should be the opposite!
-        cand = &partsColl[i];
-      }
-    }
-  }
-  return cand;
+  return role(kAssociatedB);
 }
 
 const reco::GenParticle* 
 StGenEvent::singleLepton() const 
 {
-  const reco::GenParticle* cand = 0;
-  const reco::GenParticleCollection& partsColl = *parts_;
-  for (unsigned int i = 0; i < partsColl.size(); ++i) {
-    if (reco::isLepton(partsColl[i]) && partsColl[i].mother() &&
-	std::abs(partsColl[i].mother()->pdgId())==TopDecayID::WID) {
-      cand = &partsColl[i];
-    }
-  }
-  return cand;
+  return role(kLepton);
 }
 
 const reco::GenParticle* 
 StGenEvent::singleNeutrino() const 
 {
-  const reco::GenParticle* cand=0;
-  const reco::GenParticleCollection & partsColl = *parts_;
-  for (unsigned int i = 0; i < partsColl.size(); ++i) {
-    if (reco::isNeutrino(partsColl[i]) && partsColl[i].mother() &&
-	std::abs(partsColl[i].mother()->pdgId())==TopDecayID::WID) {
-      cand = &partsColl[i];
-    }
-  }
-  return cand;
+  return role(kNeutrino);
 }
 
 const reco::GenParticle* 
 StGenEvent::singleW() const 
 {
-  const reco::GenParticle* cand=0;
-  if (singleLepton()) {
-    const reco::GenParticleCollection & partsColl = *parts_;
-    const reco::GenParticle & singleLep = *singleLepton();
-    for (unsigned int i = 0; i < partsColl.size(); ++i) {
-      if (std::abs(partsColl[i].pdgId())==TopDecayID::WID &&
-          reco::flavour(singleLep) == - reco::flavour(partsColl[i])){ 
-	// PDG Id:13=mu- 24=W+ (+24)->(-13) (-24)->(+13) opposite sign
-        cand = &partsColl[i];
-      }
-    }
-  }
-  return cand;
+  return role(kW);
 }
 
 const reco::GenParticle* 
 StGenEvent::singleTop() const 
 {
-  const reco::GenParticle* cand=0;
-  if (singleLepton()) {
-    const reco::GenParticleCollection & partsColl = *parts_;
-    const reco::GenParticle & singleLep = *singleLepton();
-    for (unsigned int i = 0; i < partsColl.size(); ++i) {
-      if (std::abs(partsColl[i].pdgId())==TopDecayID::tID &&
-          reco::flavour(singleLep)!=reco::flavour(partsColl[i])) {
-        cand = &partsColl[i];
-      }
+  return role(kTop);
+}
+
+const reco::GenParticle*
+StGenEvent::role(Role r) const
+{
+  if( !rolesFlag_.isFilled() && rolesFlag_.lock() ){
+    resolveRoles(roles_);
+    rolesFlag_.setFilled();
+  }
+  if( rolesFlag_.isFilled() )
+    return roles_[r];
+  // the cache is being filled by another thread
+  const reco::GenParticle* roles[kNumberOfRoles];
+  resolveRoles(roles);
+  return roles[r];
+}
+
+void
+StGenEvent::resolveRoles(const reco::GenParticle* roles[kNumberOfRoles]) const
+{
+  for(unsigned int r = 0; r < kNumberOfRoles; ++r)
+    roles[r] = 0;
+  if( !parts_ )
+    return;
+  // W bosons, tops and b quarks depend on the flavour of the single
+  // lepton, which is only known at the end of the pass; keep the last
+  // candidate of each flavour (index 1 for positive, 0 for negative) 
+  // and pick the one with the proper flavour afterwards
+  const reco::GenParticle* w[2] = {0, 0};
+  const reco::GenParticle* t[2] = {0, 0};
+  const reco::GenParticle* b[2] = {0, 0};
+  const reco::GenParticleCollection & partsColl = particles();
+  for (unsigned int i = 0; i < partsColl.size(); ++i) {
+    const reco::GenParticle& part = partsColl[i];
+    int pdgId = std::abs(part.pdgId());
+    if( pdgId==TopDecayID::WID ) 
+      w[reco::flavour(part)>0] = &part;
+    else if( pdgId==TopDecayID::tID ) 
+      t[reco::flavour(part)>0] = &part;
+    else if( pdgId==TopDecayID::bID ) 
+      b[reco::flavour(part)>0] = &part;
+    else if( part.mother() && std::abs(part.mother()->pdgId())==TopDecayID::WID ) {
+      if( reco::isLepton(part) ) 
+	roles[kLepton] = &part;
+      else if( reco::isNeutrino(part) ) 
+	roles[kNeutrino] = &part;
     }
   }
-  return cand;
+  if( roles[kLepton] ){
+    bool positive = reco::flavour(*roles[kLepton])>0;
+    // PDG Id:13=mu- 24=W+ (+24)->(-13) (-24)->(+13) opposite sign
+    roles[kW          ] = w[!positive];
+    roles[kTop        ] = t[!positive];
+    // ... decay b should be of opposite flavour to the lepton
+    roles[kDecayB     ] = b[!positive];
+    roles[kAssociatedB] = b[ positive];
+  }
 }
@@ -16,7 +16,7 @@ const reco::GenParticle*
 TopGenEvent::candidate(int id, unsigned int parentId) const
 {
   const reco::GenParticle* cand=0;
-  const reco::GenParticleCollection & partsColl = *parts_;
+  const reco::GenParticleCollection & partsColl = particles();
   for( unsigned int i = 0; i < partsColl.size(); ++i ) {
     if( partsColl[i].pdgId()==id ){
       if(parentId==0?true:partsColl[i].mother()&&std::abs(partsColl[i].mother()->pdgId())==(int)parentId){
@@ -35,8 +35,9 @@ TopGenEvent::print() const
       << "--------------------------------------\n"
       << "- Dump TopGenEvent Content           -\n"
       << "--------------------------------------\n";
-  for (reco::GenParticleCollection::const_iterator part = parts_->begin(); 
-       part<parts_->end(); ++part) {
+  const reco::GenParticleCollection& partsColl = particles();
+  for (reco::GenParticleCollection::const_iterator part = partsColl.begin(); 
+       part<partsColl.end(); ++part) {
     log << "pdgId:"  << std::setw(5)  << part->pdgId()     << ", "
 	<< "mass:"   << std::setw(11) << part->p4().mass() << ", "
 	<< "energy:" << std::setw(11) << part->energy()    << ", " 
@@ -48,7 +49,7 @@ int
 TopGenEvent::numberOfLeptons(bool fromWBoson) const
 {
   int lep=0;
-  const reco::GenParticleCollection& partsColl = *parts_;
+  const reco::GenParticleCollection& partsColl = particles();
   for(unsigned int i = 0; i < partsColl.size(); ++i) {
     if(reco::isLepton(partsColl[i])) {
       if(fromWBoson){
@@ -84,7 +85,7 @@ TopGenEvent::numberOfLeptons(WDecay::LeptonType typeRestriction, bool fromWBoson
     break;
   }
   int lep=0;
-  const reco::GenParticleCollection & partsColl = *parts_;
+  const reco::GenParticleCollection & partsColl = particles();
   for(unsigned int i = 0; i < partsColl.size(); ++i) {
     if(fromWBoson){
       // restrict to particles originating from the W boson
@@ -112,7 +113,7 @@ int
 TopGenEvent::numberOfBQuarks(bool fromTopQuark) const
 {
   int bq=0;
-  const reco::GenParticleCollection & partsColl = *parts_;
+  const reco::GenParticleCollection & partsColl = particles();
   for (unsigned int i = 0; i < partsColl.size(); ++i) {
    //depend if radiation qqbar are included or not
     if(std::abs(partsColl[i].pdgId())==TopDecayID::bID){
@@ -133,7 +134,8 @@ std::vector<const reco::GenParticle*>
 TopGenEvent::topSisters() const
 {
   std::vector<const reco::GenParticle*> sisters;
-  for(reco::GenParticleCollection::const_iterator part = parts_->begin(); part<parts_->end(); ++part){
+  const reco::GenParticleCollection& partsColl = particles();
+  for(reco::GenParticleCollection::const_iterator part = partsColl.begin(); part<partsColl.end(); ++part){
     if( part->numberOfMothers()==0 && std::abs(part->pdgId())!= TopDecayID::tID){
       // choose top sister which do not have a 
       // mother and are whether top nor anti-top 
@@ -150,7 +152,8 @@ const reco::GenParticle*
 TopGenEvent::daughterQuarkOfTop(bool invertCharge) const
 {
   const reco::GenParticle* cand=0;
-  for(reco::GenParticleCollection::const_iterator top = parts_->begin(); top<parts_->end(); ++top){
+  const reco::GenParticleCollection& partsColl = particles();
+  for(reco::GenParticleCollection::const_iterator top = partsColl.begin(); top<partsColl.end(); ++top){
     if( top->pdgId()==(invertCharge?-TopDecayID::tID:TopDecayID::tID) ){
       for(reco::GenParticle::const_iterator quark = top->begin(); quark<top->end(); ++quark){
 	if( std::abs(quark->pdgId())<= TopDecayID::bID ){
@@ -170,7 +173,7 @@ const reco::GenParticle*
 TopGenEvent::daughterQuarkOfWPlus(bool invertQuarkCharge, bool invertBosonCharge) const 
 {
   const reco::GenParticle* cand=0;
-  const reco::GenParticleCollection & partsColl = *parts_;
+  const reco::GenParticleCollection & partsColl = particles();
   for (unsigned int i = 0; i < partsColl.size(); ++i) {
     if(partsColl[i].mother() && partsColl[i].mother()->pdgId()==(invertBosonCharge?-TopDecayID::WID:TopDecayID::WID) &&
        std::abs(partsColl[i].pdgId())<=TopDecayID::bID && (invertQuarkCharge?reco::flavour(partsColl[i])<0:reco::flavour(partsColl[i])>0)){
@@ -184,7 +187,8 @@ std::vector<const reco::GenParticle*>
 TopGenEvent::lightQuarks(bool includingBQuarks) const 
 {
   std::vector<const reco::GenParticle*> lightQuarks;
-  for (reco::GenParticleCollection::const_iterator part = parts_->begin(); part < parts_->end(); ++part) {
+  const reco::GenParticleCollection& partsColl = particles();
+  for (reco::GenParticleCollection::const_iterator part = partsColl.begin(); part < partsColl.end(); ++part) {
     if( (includingBQuarks && std::abs(part->pdgId())==TopDecayID::bID) || std::abs(part->pdgId())<TopDecayID::bID ) {
       if( dynamic_cast<const reco::GenParticle*>( &(*part) ) == 0){
 	throw edm::Exception( edm::errors::InvalidReference, "Not a GenParticle" );
@@ -198,7 +202,8 @@ TopGenEvent::lightQuarks(bool includingBQuarks) const
 std::vector<const reco::GenParticle*> 
 TopGenEvent::radiatedGluons(int pdgId) const{
   std::vector<const reco::GenParticle*> rads;
-  for (reco::GenParticleCollection::const_iterator part = parts_->begin(); part < parts_->end(); ++part) {
+  const reco::GenParticleCollection& partsColl = particles();
+  for (reco::GenParticleCollection::const_iterator part = partsColl.begin(); part < partsColl.end(); ++part) {
     if ( part->mother() && part->mother()->pdgId()==pdgId ){
       if(part->pdgId()==TopDecayID::glueID){
 	if( dynamic_cast<const reco::GenParticle*>( &(*part) ) == 0){
@@ -210,3 +215,42 @@ TopGenEvent::radiatedGluons(int pdgId) const{
   }  
   return rads;
 }
+
+std::vector<const reco::GenParticle*>
+TopGenEvent::radiation(const reco::Candidate* emitter, const int type, const bool recursive) const
+{
+  std::vector<const reco::GenParticle*> rads;
+  const reco::GenParticleCollection& partsColl = particles();
+  const int pos = TopRadiationIndex::position(partsColl, emitter);
+  if(pos<0)
+    return rads;
+  if(!radiationIndexFlag_.isFilled() && radiationIndexFlag_.lock()){
+    radiationIndex_.build(partsColl);
+    radiationIndexFlag_.setFilled();
+  }
+  if(radiationIndexFlag_.isFilled())
+    radiationIndex_.radiation(partsColl, pos, rads, type, recursive);
+  else
+    TopRadiationIndex(partsColl).radiation(partsColl, pos, rads, type, recursive);
+  return rads;
+}
+
+const char*
+WDecay::leptonName(LeptonType type)
+{
+  switch(type) {
+  case kElec : return "electron";
+  case kMuon : return "muon";
+  case kTau  : return "tau";
+  default    : return "";
+  }
+}
+
+WDecay::LeptonType
+WDecay::leptonType(const std::string& name)
+{
+  if(name=="electron") return kElec;
+  if(name=="muon"    ) return kMuon;
+  if(name=="tau"     ) return kTau;
+  return kNone;
+}
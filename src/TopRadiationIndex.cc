@@ -0,0 +1,67 @@
+#include "AnalysisDataFormats/TopObjects/interface/TopGenEvent.h"
+#include "AnalysisDataFormats/TopObjects/interface/TopRadiationIndex.h"
+
+#include <functional>
+
+int
+TopRadiationIndex::position(const reco::GenParticleCollection& parts, const reco::Candidate* particle)
+{
+  if(!particle || parts.empty())
+    return -1;
+  const reco::GenParticle* first = &parts.front();
+  const reco::GenParticle* last  = &parts.back();
+  const reco::GenParticle* part  = dynamic_cast<const reco::GenParticle*>(particle);
+  std::less<const reco::GenParticle*> less;
+  if(!part || less(part, first) || less(last, part))
+    return -1;
+  return part-first;
+}
+
+void
+TopRadiationIndex::build(const reco::GenParticleCollection& parts)
+{
+  clear();
+  const unsigned int n = parts.size();
+  // count the radiation of each particle first to place it without reallocation
+  std::vector<int> mothers(n, -1);
+  std::vector<unsigned int> nGluons(n, 0), nPhotons(n, 0);
+  for(unsigned int i=0; i<n; ++i){
+    const int id = parts[i].pdgId();
+    if( (id!=TopDecayID::glueID && id!=TopDecayID::photID) || !parts[i].mother() )
+      continue;
+    mothers[i] = position(parts, parts[i].mother());
+    if(mothers[i]<0)
+      continue;
+    if(id==TopDecayID::glueID) ++nGluons[mothers[i]];
+    else ++nPhotons[mothers[i]];
+  }
+  ends_.resize(n);
+  gluonEnds_.resize(n);
+  std::vector<unsigned int> nextGluon(n), nextPhoton(n);
+  unsigned int end = 0;
+  for(unsigned int i=0; i<n; ++i){
+    nextGluon[i]  = end;
+    nextPhoton[i] = gluonEnds_[i] = end+nGluons[i];
+    end = ends_[i] = gluonEnds_[i]+nPhotons[i];
+  }
+  radiation_.resize(end);
+  for(unsigned int i=0; i<n; ++i){
+    if(mothers[i]<0)
+      continue;
+    if(parts[i].pdgId()==TopDecayID::glueID) radiation_[nextGluon [mothers[i]]++] = i;
+    else radiation_[nextPhoton[mothers[i]]++] = i;
+  }
+}
+
+void
+TopRadiationIndex::radiation(const reco::GenParticleCollection& parts, const unsigned int i, std::vector<const reco::GenParticle*>& result,
+			     const int type, const bool recursive) const
+{
+  const unsigned int* first = (type & kGluon ) ? begin(i) : begin(i)+numberOfGluons(i);
+  const unsigned int* last  = (type & kPhoton) ? end(i)   : begin(i)+numberOfGluons(i);
+  for(const unsigned int* rad=first; rad!=last; ++rad){
+    result.push_back(&parts[*rad]);
+    if(recursive)
+      radiation(parts, *rad, result, type, recursive);
+  }
+}
@@ -0,0 +1,81 @@
+#include "FWCore/Utilities/interface/Exception.h"
+#include "AnalysisDataFormats/TopObjects/interface/TopScanCurve.h"
+
+#include <algorithm>
+#include <cmath>
+
+TopScanCurve::TopScanCurve(const double start, const double step, const std::vector<double>& values, const Storage storage)
+{
+  set(start, step, values, storage);
+}
+
+void
+TopScanCurve::set(const double start, const double step, const std::vector<double>& values, const Storage storage)
+{
+  clear();
+  start_   = start;
+  step_    = step;
+  size_    = values.size();
+  storage_ = storage;
+  if(values.empty())
+    return;
+  double min = values[0];
+  peakIndex_ = 0;
+  for(unsigned int i=1; i<values.size(); ++i) {
+    if(values[i]>values[peakIndex_]) peakIndex_ = i;
+    if(values[i]<min) min = values[i];
+  }
+  peakValue_ = values[peakIndex_];
+  switch(storage) {
+  case kFloat :
+    values_.assign(values.begin(), values.end());
+    break;
+  case kQuantized :
+    offset_ = min;
+    scale_  = (peakValue_-min)/65535.;
+    quantized_.reserve(size_);
+    for(unsigned int i=0; i<values.size(); ++i) {
+      // rounding must not push the largest value out of the 16 bit range
+      const double q = scale_>0 ? std::floor((values[i]-offset_)/scale_+0.5) : 0.;
+      quantized_.push_back((unsigned short)std::max(0., std::min(q, 65535.)));
+    }
+    break;
+  case kPeakOnly :
+    break;
+  }
+}
+
+void
+TopScanCurve::clear()
+{
+  start_ = 0.;
+  step_  = 1.;
+  size_  = 0;
+  storage_ = kFloat;
+  values_.clear();
+  quantized_.clear();
+  offset_ = 0.;
+  scale_  = 0.;
+  peakIndex_ = -1;
+  peakValue_ = 0.;
+}
+
+double
+TopScanCurve::value(const unsigned int i) const
+{
+  switch(storage_) {
+  case kFloat     : return values_[i];
+  case kQuantized : return offset_+scale_*quantized_[i];
+  }
+  throw cms::Exception("LogicError") << "The values of a TopScanCurve stored as peak only are not available.\n";
+}
+
+std::vector<double>
+TopScanCurve::values() const
+{
+  std::vector<double> values;
+  values.reserve(size_);
+  for(unsigned int i=0; i<size_; ++i)
+    values.push_back(value(i));
+  return values;
+}
@@ -0,0 +1,179 @@
+#include "FWCore/Utilities/interface/Exception.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtColumnFile.h"
+
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+TtColumnWriter::TtColumnWriter(const std::string& fileName, const TtColumnFile::ValueType type, const unsigned int bufferSize) :
+  fileName_(fileName), file_(0), type_(type), buffer_((bufferSize>0 ? bufferSize : 1)*TtColumnFile::valueSize(type)), used_(0), entries_(0)
+{
+  file_ = std::fopen(fileName_.c_str(), "wb");
+  if(!file_)
+    throw cms::Exception("FileOpenError") << "Column file " << fileName_ << " cannot be opened for writing.\n";
+  // reserve the space of the header; it is rewritten on close
+  writeHeader();
+}
+
+TtColumnWriter::~TtColumnWriter()
+{
+  // never throw from the destructor
+  try { close(); }
+  catch(...) {}
+}
+
+void
+TtColumnWriter::fill(const double value)
+{
+  if(!file_)
+    throw cms::Exception("LogicError") << "Column file " << fileName_ << " was already closed.\n";
+  const unsigned int size = TtColumnFile::valueSize(type_);
+  if(used_+size > buffer_.size())
+    flush();
+  char* pos = &buffer_[used_];
+  switch(type_) {
+  case TtColumnFile::kInt32   : { int32_t v = (int32_t)value; std::memcpy(pos, &v, size); break; }
+  case TtColumnFile::kFloat32 : { float   v = (float  )value; std::memcpy(pos, &v, size); break; }
+  case TtColumnFile::kFloat64 : { std::memcpy(pos, &value, size); break; }
+  }
+  used_ += size;
+  ++entries_;
+}
+
+void
+TtColumnWriter::close()
+{
+  if(!file_)
+    return;
+  flush();
+  writeHeader();
+  bool failed = std::fclose(file_)!=0;
+  file_ = 0;
+  if(failed)
+    throw cms::Exception("FileWriteError") << "Column file " << fileName_ << " could not be closed properly.\n";
+}
+
+void
+TtColumnWriter::flush()
+{
+  if(used_==0)
+    return;
+  if(std::fwrite(&buffer_[0], 1, used_, file_)!=used_)
+    throw cms::Exception("FileWriteError") << "Writing to column file " << fileName_ << " failed.\n";
+  used_ = 0;
+}
+
+void
+TtColumnWriter::writeHeader()
+{
+  TtColumnFile::Header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, TtColumnFile::magic, sizeof(header.magic));
+  header.version = TtColumnFile::version;
+  header.type    = type_;
+  header.entries = entries_;
+  // the header is written at the beginning, the values are appended at the end
+  long pos = std::ftell(file_);
+  if(pos<0 || std::fseek(file_, 0, SEEK_SET)!=0 || std::fwrite(&header, sizeof(header), 1, file_)!=1
+     || (pos>0 && std::fseek(file_, pos, SEEK_SET)!=0))
+    throw cms::Exception("FileWriteError") << "Writing the header of column file " << fileName_ << " failed.\n";
+}
+
+void
+TtColumnBuffer::fill(const double value)
+{
+  switch(type_) {
+  case TtColumnFile::kInt32   : ints_.push_back((int32_t)value); break;
+  case TtColumnFile::kFloat32 : floats_.push_back((float)value); break;
+  case TtColumnFile::kFloat64 : doubles_.push_back(value); break;
+  }
+}
+
+unsigned int
+TtColumnBuffer::size() const
+{
+  switch(type_) {
+  case TtColumnFile::kInt32   : return ints_.size();
+  case TtColumnFile::kFloat32 : return floats_.size();
+  case TtColumnFile::kFloat64 : return doubles_.size();
+  }
+  return 0;
+}
+
+const void*
+TtColumnBuffer::data() const
+{
+  if(size()==0)
+    return 0;
+  switch(type_) {
+  case TtColumnFile::kInt32   : return &ints_[0];
+  case TtColumnFile::kFloat32 : return &floats_[0];
+  case TtColumnFile::kFloat64 : return &doubles_[0];
+  }
+  return 0;
+}
+
+void
+TtColumnBuffer::reserve(const unsigned int n)
+{
+  switch(type_) {
+  case TtColumnFile::kInt32   : ints_.reserve(n); break;
+  case TtColumnFile::kFloat32 : floats_.reserve(n); break;
+  case TtColumnFile::kFloat64 : doubles_.reserve(n); break;
+  }
+}
+
+TtColumnReader::TtColumnReader(const std::string& fileName) :
+  fileName_(fileName), data_(0), size_(0), type_(TtColumnFile::kInt32), entries_(0)
+{
+  int fd = ::open(fileName_.c_str(), O_RDONLY);
+  if(fd<0)
+    throw cms::Exception("FileOpenError") << "Column file " << fileName_ << " cannot be opened for reading: " << std::strerror(errno) << ".\n";
+  struct stat info;
+  if(::fstat(fd, &info)!=0 || (size_t)info.st_size<sizeof(TtColumnFile::Header)) {
+    ::close(fd);
+    throw cms::Exception("FileReadError") << "Column file " << fileName_ << " is too short to hold a column header.\n";
+  }
+  size_ = info.st_size;
+  data_ = ::mmap(0, size_, PROT_READ, MAP_SHARED, fd, 0);
+  // the mapping stays valid after the file descriptor is closed
+  ::close(fd);
+  if(data_==MAP_FAILED) {
+    data_ = 0;
+    throw cms::Exception("FileReadError") << "Column file " << fileName_ << " cannot be mapped into memory: " << std::strerror(errno) << ".\n";
+  }
+  const TtColumnFile::Header* header = (const TtColumnFile::Header*)data_;
+  std::string error;
+  if(std::memcmp(header->magic, TtColumnFile::magic, sizeof(header->magic))!=0)
+    error = "is not a column file";
+  else if(header->version!=TtColumnFile::version)
+    error = "has an unsupported layout version";
+  else if(header->type<TtColumnFile::kInt32 || header->type>TtColumnFile::kFloat64)
+    error = "has an unknown value type";
+  else if(sizeof(TtColumnFile::Header)+header->entries*TtColumnFile::valueSize((TtColumnFile::ValueType)header->type)>size_)
+    error = "is truncated";
+  if(!error.empty()) {
+    ::munmap(data_, size_);
+    data_ = 0;
+    throw cms::Exception("FileReadError") << "Column file " << fileName_ << " " << error << ".\n";
+  }
+  type_    = (TtColumnFile::ValueType)header->type;
+  entries_ = header->entries;
+}
+
+TtColumnReader::~TtColumnReader()
+{
+  if(data_)
+    ::munmap(data_, size_);
+}
+
+void
+TtColumnReader::checkType(const TtColumnFile::ValueType type) const
+{
+  if(type!=type_)
+    throw cms::Exception("LogicError") << "Column file " << fileName_ << " holds values of type " << type_
+				       << ", but values of type " << type << " were requested.\n";
+}
@@ -9,8 +9,8 @@
 TtDilepEvtSolution::TtDilepEvtSolution() 
 {
   jetCorrScheme_ = 0;
-  wpDecay_ = "NotDefined";
-  wmDecay_ = "NotDefined";
+  wpLepType_ = WDecay::kNone;
+  wmLepType_ = WDecay::kNone;
   bestSol_ = false;
   topmass_ = 0.;
   weightmax_ = 0.;
@@ -62,17 +62,20 @@ pat::Jet TtDilepEvtSolution::getJetBbar() const
 reco::Particle TtDilepEvtSolution::getLeptPos() const 
 {
   reco::Particle p;
-  if(wpDecay_ == "muon"){
-    p = reco::Particle(+1, getMuonp().p4() );
-    p.setPdgId(-11);
-  }
-  if(wpDecay_ == "electron"){
+  switch(wpLepType_){
+  case WDecay::kElec :
     p = reco::Particle(+1, getElectronp().p4() );
+    p.setPdgId(-11);
+    break;
+  case WDecay::kMuon :
+    p = reco::Particle(+1, getMuonp().p4() );
     p.setPdgId(-13);
-  }
-  if(wmDecay_ == "tau"){
+    break;
+  case WDecay::kTau  :
     p = reco::Particle(+1, getTaup().p4() );
     p.setPdgId(-15);
+    break;
+  default : break;
   }
   return p;
 }
@@ -93,18 +96,18 @@ double TtDilepEvtSolution::getLeptonResidual() const
 {
   double distance = 0.;
   if(!getGenLepp() || !getGenLepm()) return distance;
-  if(getWpDecay()=="electron")
-    distance += reco::deltaR(getElectronp(),*getGenLepp());
-  else if(getWpDecay()=="muon")
-    distance += reco::deltaR(getMuonp(),*getGenLepp());
-  else if(getWpDecay()=="tau")
-    distance += reco::deltaR(getTaup(),*getGenLepp());
-  if(getWmDecay()=="electron")
-    distance += reco::deltaR(getElectronm(),*getGenLepm());
-  else if(getWmDecay()=="muon")
-    distance += reco::deltaR(getMuonm(),*getGenLepm());
-  else if(getWmDecay()=="tau")
-    distance += reco::deltaR(getTaum(),*getGenLepm());
+  switch(wpLepType_){
+  case WDecay::kElec : distance += reco::deltaR(getElectronp(),*getGenLepp()); break;
+  case WDecay::kMuon : distance += reco::deltaR(getMuonp(),*getGenLepp());     break;
+  case WDecay::kTau  : distance += reco::deltaR(getTaup(),*getGenLepp());      break;
+  default : break;
+  }
+  switch(wmLepType_){
+  case WDecay::kElec : distance += reco::deltaR(getElectronm(),*getGenLepm()); break;
+  case WDecay::kMuon : distance += reco::deltaR(getMuonm(),*getGenLepm());     break;
+  case WDecay::kTau  : distance += reco::deltaR(getTaum(),*getGenLepm());      break;
+  default : break;
+  }
   return distance;
 }
 
@@ -115,17 +118,20 @@ double TtDilepEvtSolution::getLeptonResidual() const
 reco::Particle TtDilepEvtSolution::getLeptNeg() const 
 {
   reco::Particle p;
-  if(wmDecay_ == "electron"){
+  switch(wmLepType_){
+  case WDecay::kElec :
     p = reco::Particle(-1, getElectronm().p4() );
     p.setPdgId(11);
-  }
-  if(wmDecay_ == "muon"){
+    break;
+  case WDecay::kMuon :
     p = reco::Particle(-1, getMuonm().p4() );
     p.setPdgId(13);
-  }
-  if(wmDecay_ == "tau"){
+    break;
+  case WDecay::kTau  :
     p = reco::Particle(-1, getTaum().p4() );
     p.setPdgId(15);
+    break;
+  default : break;
   }
   return p;
 }
@@ -152,6 +158,7 @@ void TtDilepEvtSolution::setGenEvt(const edm::Handle<TtGenEvent>& aGenEvt) {
     return;
   }
   theGenEvt_ = edm::RefProd<TtGenEvent>(aGenEvt);
+  theGenEvtCache_.reset();
 }
 
 //-------------------------------------------
@@ -1,24 +1,341 @@
 #include "AnalysisDataFormats/TopObjects/interface/TtEvent.h"
-#include "CommonTools/Utils/interface/StringToEnumValue.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Exception.h"
 #include <cstring>
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
 
 // find corresponding hypotheses based on JetLepComb
 int
-TtEvent::correspondingHypo(const HypoClassKey& key1, const unsigned& hyp1, const HypoClassKey& key2) const
+TtEvent::correspondingHypo(const HypoClassId& key1, const unsigned& hyp1, const HypoClassId& key2) const
 {
+  // compare the packed combinations without copying them
+  const TtJetLepCombView comb1 = this->jetLepComb(key1, hyp1);
   for(unsigned hyp2 = 0; hyp2 < this->numberOfAvailableHypos(key2); ++hyp2) {
-    if( this->jetLeptonCombination(key1, hyp1) == this->jetLeptonCombination(key2, hyp2) )
+    if( comb1 == this->jetLepComb(key2, hyp2) )
       return hyp2;
   }
   return -1; // if no corresponding hypothesis was found
 }
 
-// return the corresponding enum value from a string
-TtEvent::HypoClassKey
-TtEvent::hypoClassKeyFromString(const std::string& label) const 
+// add a new, empty hypothesis to be filled in place
+reco::CompositeCandidate&
+TtEvent::addEventHypo(const HypoClassId& key, const std::vector<int>& jetLepComb)
 {
-  return (HypoClassKey) StringToEnumValue<HypoClassKey>(label);
+  addHypoClass(key);
+  std::vector<reco::CompositeCandidate>& hyps = evtHyp_[key];
+  hyps.resize(hyps.size()+1);
+  jetLepCombs_[key].push_back(jetLepComb);
+  systemKinematicsFlag_.reset();
+  return hyps.back();
+}
+
+// add all hypotheses of a class in one go
+void
+TtEvent::addEventHypos(const HypoClassId& key, std::vector<reco::CompositeCandidate>& hyps, const std::vector<std::vector<int> >& jetLepCombs)
+{
+  if(hyps.size()!=jetLepCombs.size())
+    throw cms::Exception("Configuration") << "Number of hypotheses (" << hyps.size() << ") and of jet lepton combinations ("
+					  << jetLepCombs.size() << ") do not match.\n";
+  systemKinematicsFlag_.reset();
+  addHypoClass(key);
+  TtJetLepCombBuffer& combs = jetLepCombs_[key];
+  for(unsigned int i=0; i<jetLepCombs.size(); ++i)
+    combs.push_back(jetLepCombs[i]);
+  std::vector<reco::CompositeCandidate>& target = evtHyp_[key];
+  if(target.empty()) {
+    target.swap(hyps);
+    return;
+  }
+  target.insert(target.end(), hyps.begin(), hyps.end());
+  hyps.clear();
+}
+
+// return the derived kinematics of the ttbar system of a given hypothesis
+TtSystemKinematics
+TtEvent::systemKinematics(const HypoClassId& key, const unsigned& cmb) const
+{
+  TtSystemKinematics kinematics;
+  if( !isHypoValid(key, cmb) )
+    return kinematics;
+  // the first caller fills the cache for all hypotheses in one go
+  if( !systemKinematicsFlag_.isFilled() && systemKinematicsFlag_.lock() ){
+    systemKinematics_.resize(evtHyp_.size());
+    for(HypoClassId id = 0; id < evtHyp_.size(); ++id){
+      std::vector<TtSystemKinematics>& target = systemKinematics_[id];
+      target.resize(evtHyp_[id].size());
+      for(unsigned int i=0; i<evtHyp_[id].size(); ++i)
+	computeSystemKinematics(evtHyp_[id][i], target[i]);
+    }
+    systemKinematicsFlag_.setFilled();
+  }
+  if( systemKinematicsFlag_.isFilled() )
+    return systemKinematics_[key][cmb];
+  // the cache is being filled by another thread
+  computeSystemKinematics(evtHyp_[key][cmb], kinematics);
+  return kinematics;
+}
+
+// compute the derived kinematics of the ttbar system of a hypothesis
+void
+TtEvent::computeSystemKinematics(const reco::CompositeCandidate& hypo, TtSystemKinematics& kinematics) const
+{
+  kinematics = TtSystemKinematics();
+  const reco::Candidate *top, *topBar, *leptonBar, *lepton;
+  systemCandidates(hypo, top, topBar, leptonBar, lepton);
+  if( !top || !topBar )
+    return;
+  math::XYZTLorentzVector leptonBarP4, leptonP4;
+  if( leptonBar ) leptonBarP4 = leptonBar->p4();
+  if( lepton    ) leptonP4    = lepton->p4();
+  kinematics.compute(top->p4(), topBar->p4(), leptonBar ? &leptonBarP4 : 0, lepton ? &leptonP4 : 0);
+}
+
+namespace {
+  // columns of the built-in scores in the order of TtEvent::HypoScoreKey
+  struct BuiltinScore { TtEvent::HypoClassKey hypoClass; const char* name; };
+  const BuiltinScore builtinScores[] = {
+    {TtEvent::kKinFit  , "fitChi2"      }, {TtEvent::kKinFit  , "fitProb"      },
+    {TtEvent::kHitFit  , "hitFitChi2"   }, {TtEvent::kHitFit  , "hitFitProb"   },
+    {TtEvent::kHitFit  , "hitFitMT"     }, {TtEvent::kHitFit  , "hitFitSigMT"  },
+    {TtEvent::kGenMatch, "genMatchSumPt"}, {TtEvent::kGenMatch, "genMatchSumDR"},
+    {TtEvent::kMVADisc , "mvaDisc"      }
+  };
+
+  const BuiltinScore& builtinScore(const TtEvent::HypoScoreKey& key)
+  {
+    if((unsigned int)key >= sizeof(builtinScores)/sizeof(builtinScores[0]))
+      throw cms::Exception("Configuration") << "Unknown TtEvent::HypoScoreKey " << key << " provided.\n";
+    return builtinScores[key];
+  }
+
+  // returned for scores that are not available
+  const std::vector<double> noScores;
+}
+
+// return the name of the column of a built-in score
+const char*
+TtEvent::scoreName(const HypoScoreKey& key)
+{
+  return builtinScore(key).name;
+}
+
+// return the hypothesis class of the column of a built-in score
+TtEvent::HypoClassId
+TtEvent::scoreHypoClass(const HypoScoreKey& key)
+{
+  return builtinScore(key).hypoClass;
+}
+
+// return the values of a built-in score, adding its column if needed
+std::vector<double>&
+TtEvent::scoreVector(const HypoScoreKey& key)
+{
+  // throws for unknown keys; the built-in scores are registered with their key as ID
+  builtinScore(key);
+  return scoreColumns_.values<double>(scoreColumns_.add((unsigned int)key, TtHypoScoreColumns::kDouble));
+}
+
+// return the index of the column of a built-in score; -1 if not available
+int
+TtEvent::scoreColumn(const HypoScoreKey& key) const
+{
+  // throws for unknown keys
+  builtinScore(key);
+  const int column = scoreColumns_.column(key);
+  return (column>=0 && scoreColumns_.valueType(column)==TtHypoScoreColumns::kDouble) ? column : -1;
+}
+
+// return the values of a built-in score
+const std::vector<double>&
+TtEvent::scores(const HypoScoreKey& key) const
+{
+  const int column = scoreColumn(key);
+  return column<0 ? noScores : scoreColumns_.values<double>(column);
+}
+
+namespace {
+  // order hypothesis indices by the value of a score; NaN values are ordered
+  // last in both directions (to keep a strict weak ordering) and ties are
+  // resolved by the index to keep the original (quality) order
+  template <typename T>
+  class ScoreOrder {
+  public:
+    ScoreOrder(const std::vector<T>& values, const bool ascending) : values_(values), ascending_(ascending) {}
+    bool operator()(const unsigned int a, const unsigned int b) const {
+      const T& va = values_[a];
+      const T& vb = values_[b];
+      const bool nanA = (va!=va);
+      const bool nanB = (vb!=vb);
+      if(nanA!=nanB) return nanB;
+      if(!nanA && va!=vb) return ascending_ ? va<vb : va>vb;
+      return a<b;
+    }
+  private:
+    const std::vector<T>& values_;
+    bool ascending_;
+  };
+
+  // fill the indices of the (at most) n best values into idx; only the first n are sorted
+  template <typename T>
+  void sortHypos(const std::vector<T>& values, const bool ascending, const unsigned int n, std::vector<unsigned int>& idx)
+  {
+    idx.resize(values.size());
+    for(unsigned int i=0; i<idx.size(); ++i)
+      idx[i] = i;
+    if(n<idx.size()) {
+      std::partial_sort(idx.begin(), idx.begin()+n, idx.end(), ScoreOrder<T>(values, ascending));
+      idx.resize(n);
+    }
+    else
+      std::sort(idx.begin(), idx.end(), ScoreOrder<T>(values, ascending));
+  }
+
+  // same as above for a column of any type
+  void sortHypos(const TtHypoScoreColumns& columns, const unsigned int column, const bool ascending, const unsigned int n, std::vector<unsigned int>& idx)
+  {
+    switch(columns.valueType(column)) {
+    case TtHypoScoreColumns::kDouble : sortHypos(columns.values<double>(column), ascending, n, idx); break;
+    case TtHypoScoreColumns::kFloat  : sortHypos(columns.values<float>(column) , ascending, n, idx); break;
+    case TtHypoScoreColumns::kInt    : sortHypos(columns.values<int>(column)   , ascending, n, idx); break;
+    }
+  }
+}
+
+// check whether lower values of a score are better
+bool
+TtEvent::lowerIsBetter(const HypoScoreKey& key)
+{
+  switch(key) {
+  case kFitProbScore    :
+  case kHitFitProbScore :
+  case kMvaDiscScore    : return false;
+  default               : return true;
+  }
+}
+
+// return the cached ranking of the hypotheses by a built-in score
+std::vector<unsigned int>
+TtEvent::ranking(const HypoScoreKey& key, const bool ascending) const
+{
+  const int column = scoreColumn(key);
+  return column<0 ? std::vector<unsigned int>() : columnRanking(column, ascending);
+}
+
+// return the cached ranking of the hypotheses by the score of a column
+std::vector<unsigned int>
+TtEvent::columnRanking(const int column, const bool ascending) const
+{
+  const unsigned int n = scoreColumns_.numberOfValues(column);
+  // the slots of all columns are made available at once; they are
+  // only resized again after a score was modified
+  if( !rankingsFlag_.isFilled() && rankingsFlag_.lock() ){
+    rankings_.assign(2*scoreColumns_.size(), std::vector<unsigned int>());
+    rankingFlags_.assign(2*scoreColumns_.size(), TopCacheFlag());
+    rankingsFlag_.setFilled();
+  }
+  const unsigned int slot = 2*column+(ascending ? 1 : 0);
+  if( rankingsFlag_.isFilled() && slot<rankings_.size() ){
+    const TopCacheFlag& flag = rankingFlags_[slot];
+    if( !flag.isFilled() && flag.lock() ){
+      sortHypos(scoreColumns_, column, ascending, n, rankings_[slot]);
+      flag.setFilled();
+    }
+    if( flag.isFilled() )
+      return rankings_[slot];
+  }
+  // the cache is being filled by another thread
+  std::vector<unsigned int> rank;
+  sortHypos(scoreColumns_, column, ascending, n, rank);
+  return rank;
+}
+
+// fill the indices of the k best hypotheses by a score
+void
+TtEvent::bestHypos(const HypoScoreKey& key, const unsigned int k, std::vector<unsigned int>& idx) const
+{
+  const int column = scoreColumn(key);
+  if(column<0) {
+    idx.clear();
+    return;
+  }
+  const bool ascending = lowerIsBetter(key);
+  const unsigned int n = std::min(scoreColumns_.numberOfValues(column), k);
+  // reuse the full ranking if it is available already
+  const unsigned int slot = 2*column+(ascending ? 1 : 0);
+  if( rankingsFlag_.isFilled() && slot<rankings_.size() && rankingFlags_[slot].isFilled() ){
+    idx.assign(rankings_[slot].begin(), rankings_[slot].begin()+n);
+    return;
+  }
+  sortHypos(scoreColumns_, column, ascending, n, idx);
+}
+
+// translate the IDs of all hypothesis classes
+void
+TtEvent::remapHypoClasses(const std::vector<unsigned int>& translation)
+{
+  // check all classes first, such that the event is left unchanged if one is not covered
+  const unsigned int n = std::max(hypoClasses_.size(), nJetsConsidered_.size());
+  if(n>0)
+    remappedHypoClass(translation, n-1);
+  for(unsigned int column=0; column<scoreColumns_.size(); ++column)
+    remappedHypoClass(translation, scoreColumns_.hypoClass(column));
+  remapHypoClassVector(hypoClasses_, translation, (unsigned char)0);
+  remapHypoClassVector(evtHyp_, translation, std::vector<reco::CompositeCandidate>());
+  remapHypoClassVector(jetLepCombs_, translation, TtJetLepCombBuffer());
+  remapHypoClassVector(nJetsConsidered_, translation, -1);
+  scoreColumns_.remapHypoClasses(translation);
+  resetRankings();
+  systemKinematicsFlag_.reset();
+}
+
+// return the translated ID of a hypothesis class
+TtEvent::HypoClassId
+TtEvent::remappedHypoClass(const std::vector<unsigned int>& translation, const HypoClassId& key)
+{
+  if(key>=translation.size())
+    throw cms::Exception("Configuration") << "Hypothesis class " << key << " is not covered by the translation of "
+					  << translation.size() << " hypothesis classes.\n";
+  return translation[key];
+}
+
+// make room for and flag a hypothesis class as available
+void
+TtEvent::addHypoClass(const HypoClassId& key)
+{
+  if(hypoClasses_.size()<=key) {
+    // make room for all registered classes at once; the hypotheses of
+    // the classes already added are swapped rather than copied
+    const unsigned int n = std::max(key+1, TtHypoClassRegistry::size());
+    hypoClasses_.resize(n, 0);
+    std::vector<std::vector<reco::CompositeCandidate> > hyps(n);
+    std::vector<TtJetLepCombBuffer> combs(n);
+    for(unsigned int id=0; id<evtHyp_.size(); ++id) {
+      hyps[id].swap(evtHyp_[id]);
+      combs[id].swap(jetLepCombs_[id]);
+    }
+    evtHyp_.swap(hyps);
+    jetLepCombs_.swap(combs);
+  }
+  hypoClasses_[key] = 1;
+}
+
+// return number of available hypothesis classes
+unsigned int
+TtEvent::numberOfAvailableHypoClasses() const
+{
+  return std::count(hypoClasses_.begin(), hypoClasses_.end(), 1);
+}
+
+// return the IDs of all available hypothesis classes
+std::vector<TtEvent::HypoClassId>
+TtEvent::availableHypoClasses() const
+{
+  std::vector<HypoClassId> ids;
+  for(HypoClassId id=0; id<hypoClasses_.size(); ++id)
+    if(hypoClasses_[id]) ids.push_back(id);
+  return ids;
 }
 
 // print pt, eta, phi, mass of a given candidate into an existing LogInfo
@@ -38,3 +355,69 @@ TtEvent::printParticle(edm::LogInfo &log, const char* name, const reco::Candidat
       << std::setw(10) << cand->mass() << "\n";
   log << resetiosflags(std::ios::scientific);
 }
+
+// append pt, eta, phi, mass of a given candidate to a dump buffer
+void
+TtEvent::dumpParticle(std::string& buffer, const char* name, const reco::Candidate* cand, const bool compact) const
+{
+  if(compact) {
+    if(!cand) dumpFormat(buffer, "\"%s\":null", name);
+    else      dumpFormat(buffer, "\"%s\":{\"pt\":%.3f,\"eta\":%.3f,\"phi\":%.3f,\"mass\":%.3e}",
+			 name, cand->pt(), cand->eta(), cand->phi(), cand->mass());
+    return;
+  }
+  if(!cand) dumpFormat(buffer, "%15s: not available!\n", name);
+  else      dumpFormat(buffer, "%15s: %7.3f; %7.3f; %7.3f; %10.3e\n", name, cand->pt(), cand->eta(), cand->phi(), cand->mass());
+}
+
+// append printf-like formated text to a dump buffer
+void
+TtEvent::dumpFormat(std::string& buffer, const char* format, ...)
+{
+  // most entries fit into the local buffer; fall back
+  // to a heap allocation only for the rare longer ones
+  char local[256];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(local, sizeof(local), format, args);
+  va_end(args);
+  if(length < 0)
+    return;
+  if(length < (int)sizeof(local)) {
+    buffer.append(local, length);
+    return;
+  }
+  std::vector<char> large(length+1);
+  va_start(args, format);
+  vsnprintf(&large[0], large.size(), format, args);
+  va_end(args);
+  buffer.append(&large[0], length);
+}
+
+// append the jet lepton combination of a hypothesis to a dump buffer
+void
+TtEvent::dumpJetLeptonCombination(std::string& buffer, const TtJetLepCombView& jets, const char* spacer, const bool compact)
+{
+  if(compact) {
+    buffer += "\"jetLepComb\":[";
+    for(unsigned int iJet = 0; iJet < jets.size(); iJet++)
+      dumpFormat(buffer, iJet==0 ? "%d" : ",%d", jets[iJet]);
+    buffer += "]";
+    return;
+  }
+  for(unsigned int iJet = 0; iJet < jets.size(); iJet++)
+    dumpFormat(buffer, "%s%d   ", spacer, jets[iJet]);
+  buffer += "\n";
+}
+
+// return a short label for a given leptonic decay channel
+const char*
+TtEvent::lepDecayLabel(const WDecay::LeptonType& type)
+{
+  switch(type) {
+  case WDecay::kElec : return "Electron";
+  case WDecay::kMuon : return "Muon";
+  case WDecay::kTau  : return "Tau";
+  default            : return "Unknown";
+  }
+}
@@ -0,0 +1,42 @@
+#include "FWCore/Utilities/interface/Exception.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtEventArrays.h"
+
+TtEventArrays::TtEventArrays(const std::vector<std::string>& hypoClasses, const std::vector<std::string>& quantities, const unsigned int maxHypos) :
+  TtEventColumnFiller(maxHypos)
+{
+  book(hypoClasses, quantities);
+}
+
+void
+TtEventArrays::fill(const std::vector<const TtEvent*>& events)
+{
+  for(unsigned int e=0; e<events.size(); ++e) {
+    if(!events[e])
+      throw cms::Exception("Configuration") << "Event " << e << " of the batch is not available.\n";
+    fill(*events[e]);
+  }
+}
+
+const TtColumnBuffer&
+TtEventArrays::column(const std::string& name) const
+{
+  // all columns are kept in memory
+  for(unsigned int c=0; c<names_.size(); ++c)
+    if(names_[c]==name)
+      return *static_cast<const TtColumnBuffer*>(columns_[c]);
+  throw cms::Exception("Configuration") << "Column '" << name << "' is not declared.\n";
+}
+
+void
+TtEventArrays::clear()
+{
+  for(unsigned int c=0; c<columns_.size(); ++c)
+    static_cast<TtColumnBuffer*>(columns_[c])->clear();
+  nEvents_ = 0;
+}
+
+TtColumnSink*
+TtEventArrays::newColumn(const std::string&, const TtColumnFile::ValueType type)
+{
+  return new TtColumnBuffer(type);
+}
@@ -0,0 +1,262 @@
+#include "FWCore/Utilities/interface/Exception.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtEventColumnFiller.h"
+
+#include <cstring>
+
+namespace {
+  // candidates of the hypotheses by the names of the accessors
+  // of the derived TtEvent classes and their daughter role paths
+  struct HypoRole { const char* name; const char* path; };
+  const HypoRole hypoRoles[] = {
+    // TtSemiLeptonicEvent
+    {"hadronicDecayTop"     , "HadTop"          }, {"hadronicDecayB"       , "HadTop/HadB"     },
+    {"hadronicDecayW"       , "HadTop/HadW"     }, {"hadronicDecayQuark"   , "HadTop/HadW/HadP"},
+    {"hadronicDecayQuarkBar", "HadTop/HadW/HadQ"}, {"leptonicDecayTop"     , "LepTop"          },
+    {"leptonicDecayB"       , "LepTop/LepB"     }, {"leptonicDecayW"       , "LepTop/LepW"     },
+    {"singleNeutrino"       , "LepTop/LepW/Nu"  }, {"singleLepton"         , "LepTop/LepW/Lep" },
+    // TtFullLeptonicEvent and TtFullHadronicEvent
+    {"top"        , "Top"                }, {"b"          , "Top/B"              }, {"wPlus"      , "Top/WPlus"          },
+    {"leptonBar"  , "Top/WPlus/LepBar"   }, {"neutrino"   , "Top/WPlus/Nu"       }, {"lightQ"     , "Top/WPlus/LightQ"   },
+    {"lightQBar"  , "Top/WPlus/LightQBar"}, {"topBar"     , "TopBar"             }, {"bBar"       , "TopBar/BBar"        },
+    {"wMinus"     , "TopBar/WMinus"      }, {"lepton"     , "TopBar/WMinus/Lep"  }, {"neutrinoBar", "TopBar/WMinus/NuBar"},
+    {"lightP"     , "TopBar/WMinus/LightP"}, {"lightPBar" , "TopBar/WMinus/LightPBar"},
+    // the hypothesis itself
+    {"topPair"    , ""                   }
+  };
+
+  // candidates of the TtGenEvent by the names of their accessors
+  enum GenRole { kGenTop, kGenTopBar, kGenB, kGenBBar, kGenWPlus, kGenWMinus, kGenLepton, kGenLeptonBar, kGenNeutrino, kGenNeutrinoBar,
+		 kGenHadTop, kGenHadB, kGenHadW, kGenHadQuark, kGenHadQuarkBar, kGenLepTop, kGenLepB, kGenLepW, kGenSingleLepton,
+		 kGenSingleNeutrino, kGenTopPair };
+  struct GenRoleName { const char* name; GenRole role; };
+  const GenRoleName genRoles[] = {
+    {"top"             , kGenTop        }, {"topBar"          , kGenTopBar        }, {"b"               , kGenB           },
+    {"bBar"            , kGenBBar       }, {"wPlus"           , kGenWPlus         }, {"wMinus"          , kGenWMinus      },
+    {"lepton"          , kGenLepton     }, {"leptonBar"       , kGenLeptonBar     }, {"neutrino"        , kGenNeutrino    },
+    {"neutrinoBar"     , kGenNeutrinoBar}, {"hadronicDecayTop", kGenHadTop        }, {"hadronicDecayB"  , kGenHadB        },
+    {"hadronicDecayW"  , kGenHadW       }, {"hadronicDecayQuark", kGenHadQuark    }, {"hadronicDecayQuarkBar", kGenHadQuarkBar},
+    {"leptonicDecayTop", kGenLepTop     }, {"leptonicDecayB"  , kGenLepB          }, {"leptonicDecayW"  , kGenLepW        },
+    {"singleLepton"    , kGenSingleLepton}, {"singleNeutrino" , kGenSingleNeutrino}, {"topPair"         , kGenTopPair     }
+  };
+
+  // return the candidate of the TtGenEvent for a given role
+  const reco::GenParticle* genCandidate(const TtGenEvent& gen, const int role)
+  {
+    switch(role) {
+    case kGenTop            : return gen.top();
+    case kGenTopBar         : return gen.topBar();
+    case kGenB              : return gen.b();
+    case kGenBBar           : return gen.bBar();
+    case kGenWPlus          : return gen.wPlus();
+    case kGenWMinus         : return gen.wMinus();
+    case kGenLepton         : return gen.lepton();
+    case kGenLeptonBar      : return gen.leptonBar();
+    case kGenNeutrino       : return gen.neutrino();
+    case kGenNeutrinoBar    : return gen.neutrinoBar();
+    case kGenHadTop         : return gen.hadronicDecayTop();
+    case kGenHadB           : return gen.hadronicDecayB();
+    case kGenHadW           : return gen.hadronicDecayW();
+    case kGenHadQuark       : return gen.hadronicDecayQuark();
+    case kGenHadQuarkBar    : return gen.hadronicDecayQuarkBar();
+    case kGenLepTop         : return gen.leptonicDecayTop();
+    case kGenLepB           : return gen.leptonicDecayB();
+    case kGenLepW           : return gen.leptonicDecayW();
+    case kGenSingleLepton   : return gen.singleLepton();
+    case kGenSingleNeutrino : return gen.singleNeutrino();
+    default                 : return 0;
+    }
+  }
+
+  // value written for candidates that are not available
+  const double noCandidate = -999.;
+  // value written for scores that are not available
+  const double noScore = -1.;
+}
+
+TtEventColumnFiller::TtEventColumnFiller(const unsigned int maxHypos) :
+  nEvents_(0), maxHypos_(maxHypos)
+{
+}
+
+TtEventColumnFiller::~TtEventColumnFiller()
+{
+  for(unsigned int c=0; c<columns_.size(); ++c)
+    delete columns_[c];
+}
+
+void
+TtEventColumnFiller::book(const std::vector<std::string>& hypoClasses, const std::vector<std::string>& quantities)
+{
+  // per-event columns of the gen event
+  for(unsigned int q=0; q<quantities.size(); ++q) {
+    if(quantities[q].compare(0, 4, "gen.")!=0)
+      continue;
+    GenColumn column;
+    if(quantities[q]=="gen.channel") {
+      column.role = -1; column.kinematic = kPt;
+      column.sink = addColumn(quantities[q], TtColumnFile::kInt32);
+      genColumns_.push_back(column);
+      continue;
+    }
+    std::string role;
+    splitQuantity(quantities[q].substr(4), role, column.kinematic);
+    column.role = -1;
+    for(unsigned int r=0; r<sizeof(genRoles)/sizeof(genRoles[0]); ++r)
+      if(role==genRoles[r].name) column.role = genRoles[r].role;
+    if(column.role<0)
+      throw cms::Exception("Configuration") << "Unknown TtGenEvent role '" << role << "' requested as column.\n";
+    column.sink = addColumn(quantities[q], TtColumnFile::kFloat32);
+    genColumns_.push_back(column);
+  }
+  // per-hypothesis columns for all classes
+  for(unsigned int c=0; c<hypoClasses.size(); ++c) {
+    HypoClass hypoClass;
+    hypoClass.key = TtHypoClassRegistry::id(hypoClasses[c]);
+    hypoClass.nHypos = addColumn(hypoClasses[c]+".nHypos", TtColumnFile::kInt32);
+    for(unsigned int q=0; q<quantities.size(); ++q) {
+      if(quantities[q].compare(0, 4, "gen.")==0)
+	continue;
+      HypoColumn column;
+      column.role = -1; column.score = -1; column.kinematic = kPt;
+      const std::string name = hypoClasses[c]+"."+quantities[q];
+      if(quantities[q]=="valid") {
+	column.sink = addColumn(name, TtColumnFile::kInt32);
+	hypoClass.columns.push_back(column);
+	continue;
+      }
+      // scores of the class are resolved once for all events; a built-in score resolves to
+      // its HypoScoreKey for the class it belongs to (e.g. "fitProb" of kKinFit) and to a
+      // score of the same name, usually not available, for all other classes
+      if(quantities[q].find('.')==std::string::npos) {
+	column.score = TtHypoScoreRegistry::registerScore(hypoClass.key, quantities[q]);
+	column.sink = addColumn(name, TtColumnFile::kFloat64);
+	hypoClass.columns.push_back(column);
+	continue;
+      }
+      // candidate: translate accessor names into role paths
+      std::string role;
+      splitQuantity(quantities[q], role, column.kinematic);
+      std::string path = role;
+      for(unsigned int r=0; r<sizeof(hypoRoles)/sizeof(hypoRoles[0]); ++r)
+	if(role==hypoRoles[r].name) path = hypoRoles[r].path;
+      std::vector<std::string> roles;
+      for(std::string::size_type begin=0, end=0; begin<path.size(); begin=end+1) {
+	end = path.find('/', begin);
+	if(end==std::string::npos) end = path.size();
+	roles.push_back(path.substr(begin, end-begin));
+      }
+      // share the resolution of identical role paths between columns
+      for(unsigned int r=0; r<rolePaths_.size(); ++r)
+	if(rolePaths_[r]==roles) column.role = r;
+      if(column.role<0) {
+	column.role = rolePaths_.size();
+	rolePaths_.push_back(roles);
+      }
+      column.sink = addColumn(name, TtColumnFile::kFloat32);
+      hypoClass.columns.push_back(column);
+    }
+    classes_.push_back(hypoClass);
+  }
+}
+
+void
+TtEventColumnFiller::fill(const TtEvent& evt)
+{
+  // per-event columns; the gen event is resolved only once
+  if(!genColumns_.empty()) {
+    const TtGenEvent* gen = evt.genEventProduct();
+    for(unsigned int c=0; c<genColumns_.size(); ++c) {
+      const GenColumn& column = genColumns_[c];
+      if(column.role<0) {
+	int channel = 0;
+	if(gen && gen->isTtBar())
+	  channel = gen->isFullHadronic() ? 1 : (gen->isSemiLeptonic() ? 2 : (gen->isFullLeptonic() ? 3 : 0));
+	column.sink->fill(channel);
+	continue;
+      }
+      if(column.role==kGenTopPair) {
+	const math::XYZTLorentzVector* p4 = gen ? gen->topPair() : 0;
+	column.sink->fill(p4 ? kinematic(*p4, column.kinematic) : noCandidate);
+	continue;
+      }
+      const reco::GenParticle* cand = gen ? genCandidate(*gen, column.role) : 0;
+      column.sink->fill(cand ? kinematic(cand->p4(), column.kinematic) : noCandidate);
+    }
+  }
+  // per-hypothesis columns; every role path is resolved once per hypothesis
+  std::vector<const reco::Candidate*> cands(rolePaths_.size());
+  for(unsigned int c=0; c<classes_.size(); ++c) {
+    const HypoClass& hypoClass = classes_[c];
+    unsigned int nHypos = evt.numberOfAvailableHypos(hypoClass.key);
+    if(maxHypos_>0 && nHypos>maxHypos_)
+      nHypos = maxHypos_;
+    hypoClass.nHypos->fill(nHypos);
+    for(unsigned int cmb=0; cmb<nHypos; ++cmb) {
+      const bool valid = evt.isHypoValid(hypoClass.key, cmb);
+      const reco::Candidate* hypo = valid ? &evt.eventHypo(hypoClass.key, cmb) : 0;
+      for(unsigned int r=0; r<rolePaths_.size(); ++r) {
+	const reco::Candidate* cand = hypo;
+	for(unsigned int d=0; cand && d<rolePaths_[r].size(); ++d)
+	  cand = cand->daughter(rolePaths_[r][d]);
+	cands[r] = cand;
+      }
+      for(unsigned int q=0; q<hypoClass.columns.size(); ++q) {
+	const HypoColumn& column = hypoClass.columns[q];
+	if(column.role>=0) {
+	  column.sink->fill(cands[column.role] ? kinematic(cands[column.role]->p4(), column.kinematic) : noCandidate);
+	}
+	else if(column.score>=0) {
+	  const int scoreColumn = evt.scoreColumns().column(column.score);
+	  column.sink->fill(scoreColumn<0 ? noScore : evt.scoreColumns().value(scoreColumn, cmb, noScore));
+	}
+	else
+	  column.sink->fill(valid ? 1 : 0);
+      }
+    }
+  }
+  ++nEvents_;
+}
+
+double
+TtEventColumnFiller::kinematic(const math::XYZTLorentzVector& p4, const Kinematic kinematic)
+{
+  switch(kinematic) {
+  case kPt       : return p4.pt();
+  case kEta      : return p4.eta();
+  case kPhi      : return p4.phi();
+  case kMass     : return p4.mass();
+  case kPx       : return p4.px();
+  case kPy       : return p4.py();
+  case kPz       : return p4.pz();
+  case kEnergy   : return p4.energy();
+  case kRapidity : return p4.Rapidity();
+  }
+  return noCandidate;
+}
+
+void
+TtEventColumnFiller::splitQuantity(const std::string& quantity, std::string& role, Kinematic& kinematic)
+{
+  static const char* names[] = {"pt", "eta", "phi", "mass", "px", "py", "pz", "energy", "rapidity"};
+  std::string::size_type dot = quantity.rfind('.');
+  if(dot==std::string::npos)
+    throw cms::Exception("Configuration") << "Quantity '" << quantity << "' requested as column is neither a score nor of the form <role>.<quantity>.\n";
+  role = quantity.substr(0, dot);
+  const std::string name = quantity.substr(dot+1);
+  for(unsigned int k=0; k<sizeof(names)/sizeof(names[0]); ++k) {
+    if(name==names[k]) {
+      kinematic = (Kinematic)k;
+      return;
+    }
+  }
+  throw cms::Exception("Configuration") << "Unknown kinematic quantity '" << name << "' requested as column.\n";
+}
+
+TtColumnSink*
+TtEventColumnFiller::addColumn(const std::string& name, const TtColumnFile::ValueType type)
+{
+  columns_.push_back(0);
+  columns_.back() = newColumn(name, type);
+  names_.push_back(name);
+  return columns_.back();
+}
@@ -0,0 +1,88 @@
+#include "FWCore/Utilities/interface/Exception.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtEventColumnReader.h"
+
+#include <algorithm>
+#include <dirent.h>
+
+TtEventColumnReader::TtEventColumnReader(const std::string& directory) :
+  directory_(directory)
+{
+  DIR* dir = ::opendir(directory_.c_str());
+  if(!dir)
+    throw cms::Exception("FileOpenError") << "Column directory " << directory_ << " cannot be opened.\n";
+  const std::string& ext = TtColumnFile::extension;
+  for(struct dirent* entry=::readdir(dir); entry; entry=::readdir(dir)) {
+    const std::string name = entry->d_name;
+    if(name.size()>ext.size() && name.compare(name.size()-ext.size(), ext.size(), ext)==0)
+      columnNames_.push_back(TtColumnFile::columnName(name.substr(0, name.size()-ext.size())));
+  }
+  ::closedir(dir);
+  std::sort(columnNames_.begin(), columnNames_.end());
+}
+
+TtEventColumnReader::~TtEventColumnReader()
+{
+  for(std::map<std::string, TtColumnReader*>::const_iterator reader=readers_.begin(); reader!=readers_.end(); ++reader)
+    delete reader->second;
+}
+
+bool
+TtEventColumnReader::isColumnAvailable(const std::string& name) const
+{
+  return std::binary_search(columnNames_.begin(), columnNames_.end(), name);
+}
+
+unsigned int
+TtEventColumnReader::numberOfEvents() const
+{
+  // any per-event column holds one entry per event
+  static const std::string nHypos = ".nHypos";
+  for(unsigned int c=0; c<columnNames_.size(); ++c) {
+    const std::string& name = columnNames_[c];
+    if(name.compare(0, 4, "gen.")==0 || (name.size()>nHypos.size() && name.compare(name.size()-nHypos.size(), nHypos.size(), nHypos)==0))
+      return reader(name).entries();
+  }
+  return 0;
+}
+
+const TtColumnReader&
+TtEventColumnReader::reader(const std::string& name) const
+{
+  std::map<std::string, TtColumnReader*>::const_iterator reader = readers_.find(name);
+  if(reader!=readers_.end())
+    return *reader->second;
+  if(!isColumnAvailable(name))
+    throw cms::Exception("Configuration") << "Column '" << name << "' is not available in " << directory_ << ".\n";
+  TtColumnReader* column = new TtColumnReader(directory_+"/"+TtColumnFile::fileName(name)+TtColumnFile::extension);
+  readers_[name] = column;
+  return *column;
+}
+
+void
+TtEventColumnReader::checkEntries(const std::string& name, const uint64_t entries, const uint64_t expected) const
+{
+  if(entries!=expected)
+    throw cms::Exception("FileReadError") << "Column '" << name << "' in " << directory_ << " has " << entries
+					  << " entries instead of " << expected << ".\n";
+}
+
+const std::vector<uint64_t>&
+TtEventColumnReader::offsets(const std::string& key) const
+{
+  std::map<std::string, std::vector<uint64_t> >::const_iterator offsets = offsets_.find(key);
+  if(offsets!=offsets_.end())
+    return offsets->second;
+  const TtColumnView<int32_t> nHypos = numberOfAvailableHypos(key);
+  std::vector<uint64_t>& sums = offsets_[key];
+  sums.reserve(nHypos.size()+1);
+  sums.push_back(0);
+  for(unsigned int evt=0; evt<nHypos.size(); ++evt)
+    sums.push_back(sums.back()+nHypos[evt]);
+  return sums;
+}
+
+TtColumnP4View
+TtEventColumnReader::p4(const std::string& name) const
+{
+  return TtColumnP4View(column<float>(name+".px"), column<float>(name+".py"), column<float>(name+".pz"), column<float>(name+".energy"));
+}
@@ -0,0 +1,22 @@
+#include "AnalysisDataFormats/TopObjects/interface/TtEventFlattener.h"
+
+TtEventFlattener::TtEventFlattener(const std::string& directory, const std::vector<std::string>& hypoClasses, const std::vector<std::string>& quantities,
+				   const unsigned int maxHypos, const unsigned int bufferSize) :
+  TtEventColumnFiller(maxHypos), directory_(directory), bufferSize_(bufferSize)
+{
+  book(hypoClasses, quantities);
+}
+
+void
+TtEventFlattener::close()
+{
+  // all columns are column files
+  for(unsigned int c=0; c<columns_.size(); ++c)
+    static_cast<TtColumnWriter*>(columns_[c])->close();
+}
+
+TtColumnSink*
+TtEventFlattener::newColumn(const std::string& name, const TtColumnFile::ValueType type)
+{
+  return new TtColumnWriter(directory_+"/"+TtColumnFile::fileName(name)+TtColumnFile::extension, type, bufferSize_);
+}
@@ -0,0 +1,192 @@
+#include "AnalysisDataFormats/TopObjects/interface/TtEventPartonMatching.h"
+
+#include <cmath>
+#include <limits>
+
+void
+TtEventPartonMatching::addParton(const reco::Candidate::LorentzVector& p4)
+{
+  partonPt_.push_back(p4.pt());
+  // eta is not defined for partons with vanishing pt, which are never matched
+  partonEta_.push_back(p4.pt()>0 ? p4.eta() : 0.);
+  partonPhi_.push_back(p4.phi());
+}
+
+void
+TtEventPartonMatching::addJet(const reco::Candidate::LorentzVector& p4)
+{
+  jetPt_.push_back(p4.pt());
+  jetEta_.push_back(p4.eta());
+  jetPhi_.push_back(p4.phi());
+}
+
+unsigned int
+TtEventPartonMatching::numberOfUnmatchedPartons() const
+{
+  unsigned int nUnmatched = 0;
+  for(unsigned int i=0; i<combination_.size(); ++i)
+    if(combination_[i]<0) ++nUnmatched;
+  return nUnmatched;
+}
+
+void
+TtEventPartonMatching::match(const Algorithm algorithm, const double maxDist)
+{
+  const unsigned int nP = nPartons(), nJ = nJets();
+  deltaR_ .resize(nP*nJ);
+  deltaPt_.resize(nP*nJ);
+  // one row per parton; the inner loop runs over contiguous jet arrays without
+  // branches, such that it can be vectorized by the compiler
+  const double* jetPt  = nJ>0 ? &jetPt_ [0] : 0;
+  const double* jetEta = nJ>0 ? &jetEta_[0] : 0;
+  const double* jetPhi = nJ>0 ? &jetPhi_[0] : 0;
+  for(unsigned int i=0; i<nP; ++i) {
+    const double pt = partonPt_[i], eta = partonEta_[i], phi = partonPhi_[i];
+    double* dR  = nJ>0 ? &deltaR_ [i*nJ] : 0;
+    double* dPt = nJ>0 ? &deltaPt_[i*nJ] : 0;
+    for(unsigned int j=0; j<nJ; ++j) {
+      const double dEta = eta-jetEta[j];
+      double dPhi = std::fabs(phi-jetPhi[j]);
+      dPhi = dPhi>M_PI ? 2*M_PI-dPhi : dPhi;
+      dR [j] = std::sqrt(dEta*dEta+dPhi*dPhi);
+      dPt[j] = std::fabs(pt-jetPt[j]);
+    }
+  }
+  combination_.assign(nP, -1);
+  switch(algorithm) {
+  case kGreedy      : matchGreedy(maxDist);      break;
+  case kUnambiguous : matchUnambiguous(maxDist); break;
+  case kOptimal     : matchOptimal(maxDist);     break;
+  }
+  // sums over all matched pairs
+  for(unsigned int i=0; i<nP; ++i) {
+    if(combination_[i]<0)
+      continue;
+    if(sumDeltaR_<0) {
+      sumDeltaR_  = 0.;
+      sumDeltaPt_ = 0.;
+    }
+    sumDeltaR_  += deltaR (i, combination_[i]);
+    sumDeltaPt_ += deltaPt(i, combination_[i]);
+  }
+}
+
+void
+TtEventPartonMatching::matchGreedy(const double maxDist)
+{
+  std::vector<bool> usedJets(nJets(), false);
+  while(true) {
+    // find the closest pair among the partons and jets not yet matched
+    int iBest = -1, jBest = -1;
+    for(unsigned int i=0; i<nPartons(); ++i) {
+      if(combination_[i]>=0)
+	continue;
+      for(unsigned int j=0; j<nJets(); ++j) {
+	if(usedJets[j] || !isAllowed(i, j, maxDist))
+	  continue;
+	if(iBest<0 || deltaR(i, j)<deltaR(iBest, jBest)) {
+	  iBest = i;
+	  jBest = j;
+	}
+      }
+    }
+    if(iBest<0)
+      break;
+    combination_[iBest] = jBest;
+    usedJets[jBest] = true;
+  }
+}
+
+void
+TtEventPartonMatching::matchUnambiguous(const double maxDist)
+{
+  // count the partons within reach of each jet and the jets within reach of each parton
+  std::vector<unsigned int> nPartonsOfJet(nJets(), 0), nJetsOfParton(nPartons(), 0);
+  for(unsigned int i=0; i<nPartons(); ++i) {
+    for(unsigned int j=0; j<nJets(); ++j) {
+      if(isAllowed(i, j, maxDist)) {
+	++nPartonsOfJet[j];
+	++nJetsOfParton[i];
+      }
+    }
+  }
+  for(unsigned int i=0; i<nPartons(); ++i) {
+    if(nJetsOfParton[i]!=1)
+      continue;
+    for(unsigned int j=0; j<nJets(); ++j)
+      if(isAllowed(i, j, maxDist) && nPartonsOfJet[j]==1) combination_[i] = j;
+  }
+}
+
+void
+TtEventPartonMatching::matchOptimal(const double maxDist)
+{
+  // as many pairs as possible are matched; among those assignments the one with the
+  // smallest sum of deltaR is chosen. This is solved as a linear assignment problem
+  // (Hungarian method, O(nPartons^2*(nPartons+nJets))): each parton gets an additional
+  // column of its own for being left unmatched, which costs more than any sum of deltaR,
+  // and pairs that cannot be matched cost more than leaving all partons unmatched
+  const unsigned int nP = nPartons(), nJ = nJets(), nC = nJ+nP;
+  if(nP==0)
+    return;
+  double sumAllowed = 0.;
+  for(unsigned int i=0; i<nP; ++i)
+    for(unsigned int j=0; j<nJ; ++j)
+      if(isAllowed(i, j, maxDist)) sumAllowed += deltaR(i, j);
+  const double unmatched = sumAllowed+1.;
+  const double forbidden = (nP+1)*unmatched;
+  std::vector<double> cost(nP*nC, forbidden);
+  for(unsigned int i=0; i<nP; ++i) {
+    for(unsigned int j=0; j<nJ; ++j)
+      if(isAllowed(i, j, maxDist)) cost[i*nC+j] = deltaR(i, j);
+    cost[i*nC+nJ+i] = unmatched;
+  }
+  // potentials of the rows and columns and the row assigned to each column; row
+  // and column 0 are auxiliary, such that rows and columns are counted from 1
+  const double inf = std::numeric_limits<double>::max();
+  std::vector<double> u(nP+1, 0.), v(nC+1, 0.);
+  std::vector<unsigned int> row(nC+1, 0), way(nC+1, 0);
+  for(unsigned int i=1; i<=nP; ++i) {
+    // find an augmenting path for row i along the shortest reduced costs
+    row[0] = i;
+    unsigned int col = 0;
+    std::vector<double> minCost(nC+1, inf);
+    std::vector<bool> visited(nC+1, false);
+    do {
+      visited[col] = true;
+      const unsigned int r = row[col];
+      double delta = inf;
+      unsigned int next = 0;
+      for(unsigned int c=1; c<=nC; ++c) {
+	if(visited[c])
+	  continue;
+	const double reduced = cost[(r-1)*nC+c-1]-u[r]-v[c];
+	if(reduced<minCost[c]) {
+	  minCost[c] = reduced;
+	  way[c] = col;
+	}
+	if(minCost[c]<delta) {
+	  delta = minCost[c];
+	  next = c;
+	}
+      }
+      for(unsigned int c=0; c<=nC; ++c) {
+	if(visited[c]) {
+	  u[row[c]] += delta;
+	  v[c] -= delta;
+	}
+	else
+	  minCost[c] -= delta;
+      }
+      col = next;
+    } while(row[col]!=0);
+    // flip the assignments along the path
+    do {
+      const unsigned int prev = way[col];
+      row[col] = row[prev];
+      col = prev;
+    } while(col!=0);
+  }
+  for(unsigned int c=1; c<=nJ; ++c)
+    if(row[c]>0 && isAllowed(row[c]-1, c-1, maxDist)) combination_[row[c]-1] = c-1;
+}
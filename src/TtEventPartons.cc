@@ -1,5 +1,8 @@
+#include "FWCore/Utilities/interface/Exception.h"
 #include "AnalysisDataFormats/TopObjects/interface/TtEventPartons.h"
 
+#include <algorithm>
+
 void
 TtEventPartons::expand(std::vector<int>& vec)
 {
@@ -23,3 +26,141 @@ TtEventPartons::prune(std::vector<const reco::Candidate*>& vec)
     }
   }
 }
+
+TtEventPartonCombinations::TtEventPartonCombinations(const std::vector<bool>& ignorePartons, const std::vector<std::vector<unsigned int> >& symmetries,
+						     const unsigned int nJets) :
+  nJets_(nJets), nLayout_(ignorePartons.size())
+{
+  // the compact encoding holds jet indices as single bytes
+  if(nJets_>256)
+    throw cms::Exception("Configuration") << "Jet parton combinations are restricted to 256 jets, " << nJets_ << " jets were requested.\n";
+  std::vector<int> index(nLayout_, -1);
+  for(unsigned int i=0; i<nLayout_; ++i) {
+    if(!ignorePartons[i]) {
+      index[i] = partons_.size();
+      partons_.push_back(i);
+    }
+  }
+  // close the set of symmetries under composition on the full layout, such that
+  // combined symmetries that keep the ignored partons in place are not lost
+  std::vector<std::vector<unsigned int> > group;
+  for(unsigned int s=0; s<symmetries.size(); ++s)
+    if(std::find(group.begin(), group.end(), symmetries[s])==group.end())
+      group.push_back(symmetries[s]);
+  for(unsigned int s=0; s<group.size(); ++s) {
+    for(unsigned int t=0; t<=s; ++t) {
+      std::vector<unsigned int> perm(nLayout_);
+      for(unsigned int i=0; i<nLayout_; ++i)
+	perm[i] = group[s][group[t][i]];
+      if(std::find(group.begin(), group.end(), perm)==group.end())
+	group.push_back(perm);
+    }
+  }
+  // translate the symmetries into permutations of the used partons; symmetries
+  // that interchange ignored and used partons do not apply
+  for(unsigned int s=0; s<group.size(); ++s) {
+    std::vector<unsigned int> perm;
+    bool valid = true, trivial = true;
+    for(unsigned int i=0; i<nLayout_ && valid; ++i) {
+      valid = ignorePartons[i]==ignorePartons[group[s][i]];
+      if(!valid || ignorePartons[i]) continue;
+      perm.push_back(index[group[s][i]]);
+      if(perm.back()!=perm.size()-1) trivial = false;
+    }
+    if(valid && !trivial && std::find(symmetries_.begin(), symmetries_.end(), perm)==symmetries_.end())
+      symmetries_.push_back(perm);
+  }
+  reset();
+}
+
+void
+TtEventPartonCombinations::reset()
+{
+  jets_.assign(partons_.size(), -1);
+  used_.assign(nJets_, false);
+  depth_ = 0;
+  done_ = partons_.size()>nJets_;
+}
+
+bool
+TtEventPartonCombinations::next(std::vector<int>& comb)
+{
+  if(done_ || !advance()) {
+    done_ = true;
+    return false;
+  }
+  comb.assign(nLayout_, -3);
+  for(unsigned int i=0; i<partons_.size(); ++i)
+    comb[partons_[i]] = jets_[i];
+  return true;
+}
+
+unsigned int
+TtEventPartonCombinations::next(std::vector<unsigned char>& buffer, const unsigned int maxCombs)
+{
+  unsigned int nCombs = 0;
+  for(; nCombs<maxCombs && !done_; ++nCombs) {
+    if(!advance()) {
+      done_ = true;
+      break;
+    }
+    for(unsigned int i=0; i<partons_.size(); ++i)
+      buffer.push_back(jets_[i]);
+  }
+  return nCombs;
+}
+
+void
+TtEventPartonCombinations::expand(const unsigned char* compact, std::vector<int>& comb) const
+{
+  comb.assign(nLayout_, -3);
+  for(unsigned int i=0; i<partons_.size(); ++i)
+    comb[partons_[i]] = compact[i];
+}
+
+bool
+TtEventPartonCombinations::advance()
+{
+  const int nPartons = partons_.size();
+  // there is exactly one (empty) assignment if all partons are ignored
+  if(nPartons==0) {
+    bool first = depth_==0;
+    depth_ = -1;
+    return first;
+  }
+  // depth first search over the jets of all partons; the search continues
+  // from the assignment returned last
+  while(depth_>=0) {
+    int& jet = jets_[depth_];
+    if(jet>=0)
+      used_[jet] = false;
+    do ++jet; while(jet<(int)nJets_ && used_[jet]);
+    if(jet==(int)nJets_) {
+      jet = -1;
+      --depth_;
+      continue;
+    }
+    used_[jet] = true;
+    if(!isCanonical(depth_+1))
+      continue;
+    if(depth_+1==nPartons)
+      return true;
+    ++depth_;
+  }
+  return false;
+}
+
+bool
+TtEventPartonCombinations::isCanonical(const unsigned int n) const
+{
+  // the assignment is dropped as soon as one of its symmetric partners
+  // is known to be lexicographically smaller
+  for(unsigned int s=0; s<symmetries_.size(); ++s) {
+    const std::vector<unsigned int>& perm = symmetries_[s];
+    for(unsigned int i=0; i<n && perm[i]<n; ++i) {
+      if(jets_[perm[i]]<jets_[i]) return false;
+      if(jets_[perm[i]]>jets_[i]) break;
+    }
+  }
+  return true;
+}
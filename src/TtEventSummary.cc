@@ -0,0 +1,56 @@
+#include "AnalysisDataFormats/TopObjects/interface/TtEventSummary.h"
+
+TtEventSummary::TtEventSummary() :
+  lepDecayTop1_(WDecay::kNone), lepDecayTop2_(WDecay::kNone), genChannel_(-1), availableHypoClasses_(0), validHypoClasses_(0),
+  topPairMassHypoClass_(0), topPairMass_(-1.), genTopPairMass_(-1.)
+{
+  for(unsigned int s=0; s<kNumberOfScores; ++s)
+    scores_[s] = -1.;
+}
+
+TtEventSummary::TtEventSummary(const TtEvent& evt, const TtEvent::HypoClassId& key) :
+  lepDecayTop1_(evt.lepDecays().first), lepDecayTop2_(evt.lepDecays().second), genChannel_(-1), availableHypoClasses_(0), validHypoClasses_(0),
+  topPairMassHypoClass_(key), topPairMass_(-1.), genTopPairMass_(-1.)
+{
+  // same channel codes as the columns of the TtEventColumnFiller
+  const TtGenEvent* gen = evt.genEventProduct();
+  if(gen) {
+    genChannel_ = 0;
+    if(gen->isTtBar()) {
+      genChannel_ = gen->isFullHadronic() ? 1 : (gen->isSemiLeptonic() ? 2 : (gen->isFullLeptonic() ? 3 : 0));
+      const math::XYZTLorentzVector* topPair = gen->topPair();
+      if(topPair)
+	genTopPairMass_ = topPair->mass();
+    }
+  }
+  for(TtEvent::HypoClassId id=0; id<kMaxHypoClasses; ++id) {
+    if(evt.isHypoClassAvailable(id))
+      availableHypoClasses_ |= 1u<<id;
+    if(evt.isHypoValid(id))
+      validHypoClasses_ |= 1u<<id;
+  }
+  for(unsigned int s=0; s<kNumberOfScores; ++s)
+    scores_[s] = evt.score((TtEvent::HypoScoreKey)s);
+  const reco::Candidate* topPair = evt.topPair(key);
+  if(topPair)
+    topPairMass_ = topPair->mass();
+}
+
+void
+TtEventSummary::remapHypoClasses(const std::vector<unsigned int>& translation)
+{
+  unsigned int available = 0, valid = 0;
+  for(TtEvent::HypoClassId id=0; id<kMaxHypoClasses; ++id) {
+    const TtEvent::HypoClassId key = id<translation.size() ? translation[id] : id;
+    if(key>=kMaxHypoClasses)
+      continue;
+    if(availableHypoClasses_>>id & 1)
+      available |= 1u<<key;
+    if(validHypoClasses_>>id & 1)
+      valid |= 1u<<key;
+  }
+  availableHypoClasses_ = available;
+  validHypoClasses_ = valid;
+  if(topPairMassHypoClass_<translation.size())
+    topPairMassHypoClass_ = translation[topPairMassHypoClass_];
+}
@@ -19,6 +19,14 @@ TtFullHadEvtPartons::TtFullHadEvtPartons(const std::vector<std::string>& partons
     else throw cms::Exception("Configuration")
       << "The following string in partonsToIgnore is not supported: " << (*str) << "\n";
   }
+  // the light quarks of each W and the top and anti-top
+  // decay branches as a whole are interchangeable
+  const unsigned int swapQ  [] = { LightQBar, LightQ   , B   , LightP   , LightPBar, BBar };
+  const unsigned int swapP  [] = { LightQ   , LightQBar, B   , LightPBar, LightP   , BBar };
+  const unsigned int swapTop[] = { LightP   , LightPBar, BBar, LightQ   , LightQBar, B    };
+  symmetries_.push_back(std::vector<unsigned int>(swapQ  , swapQ  +6));
+  symmetries_.push_back(std::vector<unsigned int>(swapP  , swapP  +6));
+  symmetries_.push_back(std::vector<unsigned int>(swapTop, swapTop+6));
 }
 
 std::vector<const reco::Candidate*>
@@ -1,6 +1,5 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "AnalysisDataFormats/TopObjects/interface/TtFullHadronicEvent.h"
-#include "AnalysisDataFormats/TopObjects/interface/TtFullHadEvtPartons.h"
 
 // print info via MessageLogger
 void
@@ -9,108 +8,151 @@ TtFullHadronicEvent::print(const int verbosity) const
   if(verbosity%10<=0)
     return;
 
-  edm::LogInfo log("TtFullHadronicEvent");
+  std::string buffer;
+  buffer.reserve(4096);
+  dump(buffer, verbosity);
+  edm::LogInfo("TtFullHadronicEvent") << buffer;
+}
+
+// format the content of the structure into a dump buffer
+void
+TtFullHadronicEvent::dump(std::string& buffer, const int verbosity, const bool compact) const
+{
+  buffer.clear();
+  if(verbosity%10<=0)
+    return;
 
-  log << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ \n";
+  buffer += compact ? "{" : "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ \n";
 
-  // get some information from the genEvent
-  if( !genEvt_ ) log << " TtGenEvent not available! \n";
+  // get some information from the genEvent (if available);
+  // the product is resolved only once for the whole dump
+  const TtGenEvent* genEvt = genEventProduct();
+  if( !genEvt ) buffer += compact ? "\"genEvent\":null" : " TtGenEvent not available! \n";
   else {
-    log << " TtGenEvent says: ";
-    if( !this->genEvent()->isTtBar() )            log << "Not TtBar";
-    else if( this->genEvent()->isFullHadronic() ) log << "Fully Hadronic TtBar";
-    else if( this->genEvent()->isSemiLeptonic() ) log << "Semi-leptonic TtBar";
-    else if( this->genEvent()->isFullLeptonic() ) log << "Fully Leptonic TtBar";
-    log << "\n";
+    const char* decay = "";
+    if( !genEvt->isTtBar() )            decay = "Not TtBar";
+    else if( genEvt->isFullHadronic() ) decay = "Fully Hadronic TtBar";
+    else if( genEvt->isSemiLeptonic() ) decay = "Semi-leptonic TtBar";
+    else if( genEvt->isFullLeptonic() ) decay = "Fully Leptonic TtBar";
+    dumpFormat(buffer, compact ? "\"genEvent\":{\"decay\":\"%s\"}" : " TtGenEvent says: %s\n", decay);
   }
   // get number of available hypothesis classes
-  log << " Number of available event hypothesis classes: " << this->numberOfAvailableHypoClasses() << " \n";
-
-  // create a legend for the jetLepComb
-  log << " - JetCombi    : ";
-  for(unsigned idx = 0; idx < 6; idx++) {
-    switch(idx) {
-    case TtFullHadEvtPartons::LightQ    : log << "  LightQ  "; break;
-    case TtFullHadEvtPartons::LightQBar : log << " LightQBar"; break;
-    case TtFullHadEvtPartons::B         : log << "     B    "; break;
-    case TtFullHadEvtPartons::LightP    : log << "   LightP "; break;
-    case TtFullHadEvtPartons::LightPBar : log << " LightPBar"; break;
-    case TtFullHadEvtPartons::BBar      : log << "    BBar  "; break;
-    }
+  if(compact) dumpFormat(buffer, ",\"numberOfAvailableHypoClasses\":%u,\"hypoClasses\":[", this->numberOfAvailableHypoClasses());
+  else {
+    dumpFormat(buffer, " Number of available event hypothesis classes: %u \n", this->numberOfAvailableHypoClasses());
+    // create a legend for the jetLepComb
+    buffer += " - JetCombi    :   LightQ   LightQBar     B       LightP  LightPBar    BBar  \n";
   }
-  log << "\n";
-
 
   // get details from the hypotheses
-  typedef std::map<HypoClassKey, std::vector<HypoCombPair> >::const_iterator EventHypo;
-  for(EventHypo hyp = evtHyp_.begin(); hyp != evtHyp_.end(); ++hyp) {
-    HypoClassKey hypKey = (*hyp).first;
-    // header for each hypothesis
-    log << "---------------------------------------------------------------------------- \n";
+  const std::vector<HypoClassId> hypoClassIds = availableHypoClasses();
+  for(std::vector<HypoClassId>::const_iterator hyp = hypoClassIds.begin(); hyp != hypoClassIds.end(); ++hyp) {
+    HypoClassId hypKey = *hyp;
+    const std::vector<reco::CompositeCandidate>& hypos = evtHyp_[hypKey];
+    // header for each hypothesis; classes registered at runtime are labeled by their name
+    const std::string name = hypKey > kHitFit ? TtHypoClassRegistry::name(hypKey) : std::string();
+    const char* label = 0;
+    bool applicable = false;
     switch(hypKey) {
-    case kGeom              : log << " Geom not (yet) applicable to TtFullHadronicEvent --> skipping"             ; continue;
-    case kWMassMaxSumPt     : log << " WMassMaxSumPt not (yet) applicable to TtFullHadronicEvent --> skipping"    ; continue;
-    case kMaxSumPtWMass     : log << " MaxSumPtWMass not (yet) applicable to TtFullHadronicEvent --> skipping"    ; continue;
-    case kGenMatch          : log << " GenMatch"                                                                  ; break;
-    case kMVADisc           : log << " MVADisc not (yet) applicable to TtFullHadronicEvent --> skipping"          ; continue;
-    case kKinFit            : log << " KinFit"                                                                    ; break;
-    case kKinSolution       : log << " KinSolution not (yet) applicable to TtFullHadronicEvent --> skipping"      ; continue;
-    case kWMassDeltaTopMass : log << " WMassDeltaTopMass not (yet) applicable to TtFullHadronicEvent --> skipping"; continue;
-    case kHitFit            : log << " HitFit not (yet) applicable to TtFullHadronicEvent --> skipping"           ; continue;
-    default                 : log << " Unknown TtEvent::HypoClassKey provided --> skipping"                       ; continue;
+    case kGeom              : label = "Geom"             ; break;
+    case kWMassMaxSumPt     : label = "WMassMaxSumPt"    ; break;
+    case kMaxSumPtWMass     : label = "MaxSumPtWMass"    ; break;
+    case kGenMatch          : label = "GenMatch"         ; applicable = true; break;
+    case kMVADisc           : label = "MVADisc"          ; break;
+    case kKinFit            : label = "KinFit"           ; applicable = true; break;
+    case kKinSolution       : label = "KinSolution"      ; break;
+    case kWMassDeltaTopMass : label = "WMassDeltaTopMass"; break;
+    case kHitFit            : label = "HitFit"           ; break;
+    default                 : label = name.c_str()       ; applicable = true; break;
     }
-    log << "-Hypothesis: \n";
-    unsigned nOfHyp = this->numberOfAvailableHypos(hypKey);
-    if( nOfHyp > 1 ) {
-      log << " * Number of available jet combinations: " << nOfHyp << " \n";
-      if(verbosity < 10) log << " The following was found to be the best one: \n";
+    if(compact) {
+      dumpFormat(buffer, "%s{\"key\":\"%s\"", hyp==hypoClassIds.begin() ? "" : ",", label);
+      if(!applicable) {
+	buffer += ",\"applicable\":false}";
+	continue;
+      }
+    }
+    else {
+      buffer += "---------------------------------------------------------------------------- \n";
+      if(!applicable) {
+	dumpFormat(buffer, " %s not (yet) applicable to TtFullHadronicEvent --> skipping\n", label);
+	continue;
+      }
+    }
+    unsigned nOfHyp = hypos.size();
+    if(compact)
+      dumpFormat(buffer, ",\"numberOfAvailableHypos\":%u,\"hypos\":[", nOfHyp);
+    else {
+      dumpFormat(buffer, " %s-Hypothesis: \n", label);
+      if( nOfHyp > 1 ) {
+	dumpFormat(buffer, " * Number of available jet combinations: %u \n", nOfHyp);
+	if(verbosity < 10) buffer += " The following was found to be the best one: \n";
+      }
     }
     // if verbosity level is smaller than 10, never show more than the best jet combination
-    if(verbosity < 10)
+    if(verbosity < 10 && nOfHyp > 1)
       nOfHyp = 1;
     for(unsigned cmb=0; cmb<nOfHyp; ++cmb) {
+      const reco::CompositeCandidate& hypo = hypos[cmb];
       // check if hypothesis is valid
-      if( !this->isHypoValid(hypKey, cmb) )
-	log << " * Not valid! \n";
+      if( hypo.roles().empty() ) {
+	if(compact) dumpFormat(buffer, "%s{\"cmb\":%u,\"valid\":false}", cmb==0 ? "" : ",", cmb);
+	else buffer += " * Not valid! \n";
+	continue;
+      }
       // get meta information for valid hypothesis
-      else {
-	// jetLepComb
-	log << " * JetCombi    :";
-	std::vector<int> jets = this->jetLeptonCombination( hypKey , cmb );
-	for(unsigned int iJet = 0; iJet < jets.size(); iJet++) {
-	  log << "      " << jets[iJet] << "   ";
+      if(compact) dumpFormat(buffer, "%s{\"cmb\":%u,\"valid\":true,", cmb==0 ? "" : ",", cmb);
+      else buffer += " * JetCombi    :";
+      dumpJetLeptonCombination(buffer, jetLepComb(hypKey, cmb), "      ", compact);
+      // specialties for some hypotheses
+      switch(hypKey) {
+      case kGenMatch :
+	dumpFormat(buffer, compact ? ",\"genMatchSumDR\":%g,\"genMatchSumPt\":%g" : " * Sum(DeltaR) : %g \n * Sum(DeltaPt): %g \n",
+		   this->genMatchSumDR(cmb), this->genMatchSumPt(cmb)); break;
+      case kKinFit   :
+	dumpFormat(buffer, compact ? ",\"fitChi2\":%g,\"fitProb\":%g" : " * Chi^2       : %g \n * Prob(Chi^2) : %g \n",
+		   this->fitChi2(cmb), this->fitProb(cmb)); break;
+      default        : break;
+      }
+      // kinematic quantities of particles (if last digit of verbosity level > 1);
+      // the decay tree is walked once instead of once per accessor
+      if(verbosity%10 >= 2) {
+	const reco::Candidate* top    = hypo.daughter(TtFullHadDaughter::Top   );
+	const reco::Candidate* wPlus  = top    ? top   ->daughter(TtFullHadDaughter::WPlus ) : 0;
+	const reco::Candidate* topBar = hypo.daughter(TtFullHadDaughter::TopBar);
+	const reco::Candidate* wMinus = topBar ? topBar->daughter(TtFullHadDaughter::WMinus) : 0;
+	if(!compact) buffer += " * Candidates (pt; eta; phi; mass) :\n";
+	const char* sep = compact ? "," : "";
+	if(verbosity%10 >= 3) {
+	  buffer += sep; dumpParticle(buffer, compact ? "topPair" : "top pair", &hypo, compact);
 	}
-	log << "\n";
-	// specialties for some hypotheses
-	switch(hypKey) {
-	case kGenMatch : log << " * Sum(DeltaR) : " << this->genMatchSumDR(cmb) << " \n"
-			     << " * Sum(DeltaPt): " << this->genMatchSumPt(cmb) << " \n"; break;
-	case kKinFit   : log << " * Chi^2       : " << this->fitChi2(cmb)       << " \n"
-			     << " * Prob(Chi^2) : " << this->fitProb(cmb)       << " \n"; break;
-	default        : break;
+	buffer += sep; dumpParticle(buffer, compact ? "top"   : "top       ", top  , compact);
+	buffer += sep; dumpParticle(buffer, compact ? "wPlus" : "W plus    ", wPlus, compact);
+	if(verbosity%10 >= 3) {
+	  buffer += sep; dumpParticle(buffer, compact ? "b"         : "b         ", top   ? top  ->daughter(TtFullHadDaughter::B        ) : 0, compact);
+	  buffer += sep; dumpParticle(buffer, compact ? "lightQ"    : "lightQ    ", wPlus ? wPlus->daughter(TtFullHadDaughter::LightQ   ) : 0, compact);
+	  buffer += sep; dumpParticle(buffer, compact ? "lightQBar" : "lightQBar ", wPlus ? wPlus->daughter(TtFullHadDaughter::LightQBar) : 0, compact);
 	}
-	// kinematic quantities of particles (if last digit of verbosity level > 1)
-	if(verbosity%10 >= 2) {
-	  log << " * Candidates (pt; eta; phi; mass) :\n";
-	  if(verbosity%10 >= 3)
-	    printParticle(log, "top pair", this->topPair(hypKey, cmb));
-	  printParticle(log, "top       ", this->top  (hypKey, cmb));
-	  printParticle(log, "W plus    ", this->wPlus(hypKey, cmb));
-	  if(verbosity%10 >= 3) {
-	    printParticle(log, "b         ", this->b        (hypKey, cmb));
-	    printParticle(log, "lightQ    ", this->lightQ   (hypKey, cmb));
-	    printParticle(log, "lightQBar ", this->lightQBar(hypKey, cmb));
-	  }
-	  printParticle(log, "topBar    ", this->topBar(hypKey, cmb));
-	  printParticle(log, "W minus   ", this->wMinus(hypKey, cmb));
-	  if(verbosity%10 >= 3) {
-	    printParticle(log, "bBar      ", this->bBar     (hypKey, cmb));
-	    printParticle(log, "lightP    ", this->lightP   (hypKey, cmb));
-	    printParticle(log, "lightPBar ", this->lightPBar(hypKey, cmb));
-	  }
+	buffer += sep; dumpParticle(buffer, compact ? "topBar" : "topBar    ", topBar, compact);
+	buffer += sep; dumpParticle(buffer, compact ? "wMinus" : "W minus   ", wMinus, compact);
+	if(verbosity%10 >= 3) {
+	  buffer += sep; dumpParticle(buffer, compact ? "bBar"      : "bBar      ", topBar ? topBar->daughter(TtFullHadDaughter::BBar     ) : 0, compact);
+	  buffer += sep; dumpParticle(buffer, compact ? "lightP"    : "lightP    ", wMinus ? wMinus->daughter(TtFullHadDaughter::LightP   ) : 0, compact);
+	  buffer += sep; dumpParticle(buffer, compact ? "lightPBar" : "lightPBar ", wMinus ? wMinus->daughter(TtFullHadDaughter::LightPBar) : 0, compact);
 	}
       }
+      if(compact) buffer += "}";
     }
+    if(compact) buffer += "]}";
   }
-  log << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
+  buffer += compact ? "]}" : "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
+}
+
+void
+TtFullHadronicEvent::systemCandidates(const reco::CompositeCandidate& hypo, const reco::Candidate*& top, const reco::Candidate*& topBar,
+				      const reco::Candidate*& leptonBar, const reco::Candidate*& lepton) const
+{
+  top    = hypo.daughter(TtFullHadDaughter::Top   );
+  topBar = hypo.daughter(TtFullHadDaughter::TopBar);
+  leptonBar = lepton = 0;
 }
@@ -0,0 +1,231 @@
+#include "TMath.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtDilepEvtSolution.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtFullLeptonicEvent.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtFullLepKinSolutionScan.h"
+
+#include <cmath>
+#include <complex>
+
+TtFullLepKinSolutionScan::TtFullLepKinSolutionScan(const double topMassBegin, const double topMassEnd, const double topMassStep,
+						   const std::vector<double>& nuParameters, const double wMass) :
+  wMass_(wMass), nuParameters_(nuParameters)
+{
+  if(nuParameters_.size()!=4)
+    throw cms::Exception("Configuration") << "The neutrino energy spectrum needs 4 parameters, " << nuParameters_.size() << " were given.\n";
+  if(topMassStep<=0)
+    throw cms::Exception("Configuration") << "The step of the top mass scan has to be positive.\n";
+  // the grid is computed from the index to avoid accumulating rounding errors
+  for(unsigned int i=0; topMassBegin+i*topMassStep<=topMassEnd+1e-9*topMassStep; ++i)
+    topMasses_.push_back(topMassBegin+i*topMassStep);
+}
+
+TtFullLepKinSolutionScan::Solution
+TtFullLepKinSolutionScan::solve(const math::XYZTLorentzVector& b, const math::XYZTLorentzVector& bBar, const math::XYZTLorentzVector& leptonBar,
+				const math::XYZTLorentzVector& lepton, const double metPx, const double metPy) const
+{
+  Solution solution;
+  // the neutrino is parametrized in its transverse momentum (x, y), the
+  // anti-neutrino in (metPx-x, metPy-y)
+  const Branch top = branch(leptonBar, b), topBar = branch(lepton, bBar);
+  if(!top.valid || !topBar.valid)
+    return solution;
+  // conic coefficients independent of the top mass; the conic of a branch reads
+  // A*x^2+B*x*y+C*y^2+D*x+E*y+F = 0 with D, E and F depending on the top mass
+  const double a1 = top   .ex*top   .ex-top   .zx*top   .zx-1., b1 = 2*(top   .ex*top   .ey-top   .zx*top   .zy), c1 = top   .ey*top   .ey-top   .zy*top   .zy-1.;
+  const double a2 = topBar.ex*topBar.ex-topBar.zx*topBar.zx-1., b2 = 2*(topBar.ex*topBar.ey-topBar.zx*topBar.zy), c2 = topBar.ey*topBar.ey-topBar.zy*topBar.zy-1.;
+  // coefficients depending on the top mass for all grid points; the conic
+  // of the anti-neutrino is transformed to (x, y)
+  const unsigned int n = topMasses_.size();
+  std::vector<double> e0(n), z0(n), e0Bar(n), z0Bar(n), d1(n), e1(n), f1(n), d2(n), e2(n), f2(n);
+  for(unsigned int i=0; i<n; ++i) {
+    const double mTop2 = topMasses_[i]*topMasses_[i];
+    e0   [i] = top   .e0Const+top   .e0Slope*mTop2; z0   [i] = top   .z0Const+top   .z0Slope*mTop2;
+    e0Bar[i] = topBar.e0Const+topBar.e0Slope*mTop2; z0Bar[i] = topBar.z0Const+topBar.z0Slope*mTop2;
+    d1[i] = 2*(e0[i]*top.ex-z0[i]*top.zx);
+    e1[i] = 2*(e0[i]*top.ey-z0[i]*top.zy);
+    f1[i] = e0[i]*e0[i]-z0[i]*z0[i];
+    const double d = 2*(e0Bar[i]*topBar.ex-z0Bar[i]*topBar.zx);
+    const double e = 2*(e0Bar[i]*topBar.ey-z0Bar[i]*topBar.zy);
+    const double f = e0Bar[i]*e0Bar[i]-z0Bar[i]*z0Bar[i];
+    d2[i] = -2*a2*metPx-b2*metPy-d;
+    e2[i] = -2*c2*metPy-b2*metPx-e;
+    f2[i] = a2*metPx*metPx+b2*metPx*metPy+c2*metPy*metPy+d*metPx+e*metPy+f;
+  }
+  std::vector<double> roots;
+  for(unsigned int i=0; i<n; ++i) {
+    // both conics as quadratic polynomials in y with coefficients depending on x:
+    // c_k*y^2 + (b_k*x+e_k)*y + (a_k*x^2+d_k*x+f_k); their resultant is a quartic
+    // polynomial in x, whose roots give the intersections
+    const double u[3] = { c1*f2[i]-c2*f1[i], c1*d2[i]-c2*d1[i], c1*a2-c2*a1 };
+    const double v[2] = { c1*e2[i]-c2*e1[i], c1*b2-c2*b1 };
+    const double w[4] = { e1[i]*f2[i]-e2[i]*f1[i], e1[i]*d2[i]+b1*f2[i]-e2[i]*d1[i]-b2*f1[i],
+			  e1[i]*a2+b1*d2[i]-e2[i]*a1-b2*d1[i], b1*a2-b2*a1 };
+    const double res[5] = { u[0]*u[0]-v[0]*w[0], 2*u[0]*u[1]-v[0]*w[1]-v[1]*w[0], u[1]*u[1]+2*u[0]*u[2]-v[0]*w[2]-v[1]*w[1],
+			    2*u[1]*u[2]-v[0]*w[3]-v[1]*w[2], u[2]*u[2]-v[1]*w[3] };
+    realRoots(res, roots);
+    for(unsigned int r=0; r<roots.size(); ++r) {
+      const double x = roots[r];
+      const double vx = v[0]+v[1]*x;
+      if(vx==0)
+	continue;
+      // common root in y of both quadratic polynomials
+      const double y = -(u[0]+u[1]*x+u[2]*x*x)/vx;
+      const double nuE    = e0   [i]+top   .ex*x+top   .ey*y;
+      const double nuBarE = e0Bar[i]+topBar.ex*(metPx-x)+topBar.ey*(metPy-y);
+      if(nuE<=0 || nuBarE<=0)
+	continue;
+      const double weight = nuWeight(nuE, topMasses_[i])*nuWeight(nuBarE, topMasses_[i]);
+      if(weight>solution.weight) {
+	solution.weight  = weight;
+	solution.topMass = topMasses_[i];
+	solution.neutrino    = math::XYZTLorentzVector(x, y, z0[i]+top.zx*x+top.zy*y, nuE);
+	solution.neutrinoBar = math::XYZTLorentzVector(metPx-x, metPy-y, z0Bar[i]+topBar.zx*(metPx-x)+topBar.zy*(metPy-y), nuBarE);
+      }
+    }
+  }
+  return solution;
+}
+
+std::vector<TtFullLepKinSolutionScan::Solution>
+TtFullLepKinSolutionScan::solve(const std::vector<math::XYZTLorentzVector>& jets, const math::XYZTLorentzVector& leptonBar,
+				const math::XYZTLorentzVector& lepton, const double metPx, const double metPy,
+				std::vector<std::pair<unsigned int, unsigned int> >& combs, const int maxNJets) const
+{
+  const unsigned int nJets = (maxNJets<0 || (unsigned int)maxNJets>jets.size()) ? jets.size() : maxNJets;
+  std::vector<Solution> solutions;
+  combs.clear();
+  for(unsigned int ib=0; ib<nJets; ++ib) {
+    for(unsigned int ibBar=0; ibBar<nJets; ++ibBar) {
+      if(ib==ibBar)
+	continue;
+      combs.push_back(std::make_pair(ib, ibBar));
+      solutions.push_back(solve(jets[ib], jets[ibBar], leptonBar, lepton, metPx, metPy));
+    }
+  }
+  return solutions;
+}
+
+int
+TtFullLepKinSolutionScan::best(const std::vector<Solution>& solutions)
+{
+  int best = -1;
+  for(unsigned int i=0; i<solutions.size(); ++i)
+    if(solutions[i].isValid() && (best<0 || solutions[i].weight>solutions[best].weight)) best = i;
+  return best;
+}
+
+std::vector<double>
+TtFullLepKinSolutionScan::weights(const std::vector<Solution>& solutions)
+{
+  std::vector<double> weights;
+  weights.reserve(solutions.size());
+  for(unsigned int i=0; i<solutions.size(); ++i)
+    weights.push_back(solutions[i].weight);
+  return weights;
+}
+
+void
+TtFullLepKinSolutionScan::fill(TtFullLeptonicEvent& evt, const std::vector<Solution>& solutions)
+{
+  evt.setSolWeight(weights(solutions));
+}
+
+void
+TtFullLepKinSolutionScan::fill(TtDilepEvtSolution& sol, const Solution& solution)
+{
+  sol.setRecTopMass(solution.topMass);
+  sol.setRecWeightMax(solution.weight);
+}
+
+TtFullLepKinSolutionScan::Branch
+TtFullLepKinSolutionScan::branch(const math::XYZTLorentzVector& lepton, const math::XYZTLorentzVector& b) const
+{
+  // the W mass constraint E_l*E-p_l*p = k1 and the top mass constraint E_b*E-p_b*p = k2
+  // are linear in the neutrino momentum p and energy E; they are solved for E and pz
+  Branch branch;
+  const double det = lepton.pz()*b.energy()-lepton.energy()*b.pz();
+  branch.valid = det!=0;
+  if(!branch.valid)
+    return branch;
+  const double k1 = 0.5*(wMass_*wMass_-lepton.M2());
+  // k2 = mTop^2/2 + k2Const
+  const double k2Const = -0.5*(wMass_*wMass_+b.M2())-(b.energy()*lepton.energy()-b.px()*lepton.px()-b.py()*lepton.py()-b.pz()*lepton.pz());
+  branch.ex = (lepton.pz()*b.px()-b.pz()*lepton.px())/det;
+  branch.ey = (lepton.pz()*b.py()-b.pz()*lepton.py())/det;
+  branch.zx = (lepton.energy()*b.px()-b.energy()*lepton.px())/det;
+  branch.zy = (lepton.energy()*b.py()-b.energy()*lepton.py())/det;
+  branch.e0Const = (lepton.pz()*k2Const-b.pz()*k1)/det;
+  branch.e0Slope = 0.5*lepton.pz()/det;
+  branch.z0Const = (lepton.energy()*k2Const-b.energy()*k1)/det;
+  branch.z0Slope = 0.5*lepton.energy()/det;
+  return branch;
+}
+
+void
+TtFullLepKinSolutionScan::realRoots(const double* c, std::vector<double>& roots)
+{
+  roots.clear();
+  // degree of the polynomial, neglecting coefficients that vanish within precision
+  double scale = 0;
+  for(unsigned int k=0; k<5; ++k)
+    scale = std::max(scale, std::fabs(c[k]));
+  int degree = 4;
+  while(degree>0 && std::fabs(c[degree])<=1e-12*scale)
+    --degree;
+  if(degree==0)
+    return;
+  // all complex roots by the Durand-Kerner iteration, starting from points
+  // on a circle with the radius of the Cauchy bound of the roots
+  double radius = 0;
+  for(int k=0; k<degree; ++k)
+    radius = std::max(radius, std::fabs(c[k]/c[degree]));
+  radius += 1.;
+  std::complex<double> z[4];
+  const std::complex<double> seed(0.4, 0.9);
+  for(int k=0; k<degree; ++k)
+    z[k] = radius*std::pow(seed/std::abs(seed), k+1)*0.5;
+  for(unsigned int iter=0; iter<500; ++iter) {
+    double change = 0;
+    for(int k=0; k<degree; ++k) {
+      std::complex<double> num = c[degree];
+      for(int j=degree-1; j>=0; --j)
+	num = num*z[k]+c[j];
+      std::complex<double> den = c[degree];
+      for(int j=0; j<degree; ++j)
+	if(j!=k) den *= z[k]-z[j];
+      if(std::abs(den)==0)
+	den = 1e-30;
+      const std::complex<double> delta = num/den;
+      z[k] -= delta;
+      change = std::max(change, std::abs(delta));
+    }
+    if(change<=1e-14*radius)
+      break;
+  }
+  // keep the (nearly) real roots and polish them with Newton steps
+  for(int k=0; k<degree; ++k) {
+    if(std::fabs(z[k].imag())>1e-6*(1.+std::abs(z[k])))
+      continue;
+    double x = z[k].real();
+    for(unsigned int iter=0; iter<3; ++iter) {
+      double p = c[degree], dp = 0;
+      for(int j=degree-1; j>=0; --j) {
+	dp = dp*x+p;
+	p = p*x+c[j];
+      }
+      if(dp==0)
+	break;
+      x -= p/dp;
+    }
+    roots.push_back(x);
+  }
+}
+
+double
+TtFullLepKinSolutionScan::nuWeight(const double energy, const double topMass) const
+{
+  const double mpv   = nuParameters_[0]+nuParameters_[1]*topMass;
+  const double sigma = nuParameters_[2]+nuParameters_[3]*topMass;
+  return sigma>0 ? TMath::Landau(energy, mpv, sigma) : 0.;
+}
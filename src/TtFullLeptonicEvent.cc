@@ -1,6 +1,5 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "AnalysisDataFormats/TopObjects/interface/TtFullLeptonicEvent.h"
-#include "AnalysisDataFormats/TopObjects/interface/TtFullLepEvtPartons.h"
 
 // print info via MessageLogger
 void
@@ -9,118 +8,173 @@ TtFullLeptonicEvent::print(const int verbosity) const
   if(verbosity%10 <= 0)
     return;
 
-  edm::LogInfo log("TtFullLeptonicEvent");
+  std::string buffer;
+  buffer.reserve(4096);
+  dump(buffer, verbosity);
+  edm::LogInfo("TtFullLeptonicEvent") << buffer;
+}
+
+// format the content of the structure into a dump buffer
+void
+TtFullLeptonicEvent::dump(std::string& buffer, const int verbosity, const bool compact) const
+{
+  buffer.clear();
+  if(verbosity%10 <= 0)
+    return;
 
-  log << "+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ \n";
+  buffer += compact ? "{" : "+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ \n";
 
-  // get some information from the genEvent
-  log << " TtGenEvent says: ";
-  if( !this->genEvent()->isTtBar() )            log << "Not TtBar";
-  else if( this->genEvent()->isFullHadronic() ) log << "Fully Hadronic TtBar";
-  else if( this->genEvent()->isSemiLeptonic() ) log << "Semi-leptonic TtBar";
-  else if( this->genEvent()->isFullLeptonic() ) {
-    log << "Fully Leptonic TtBar, ";
-    switch( this->genEvent()->fullLeptonicChannel().first ) {
-    case WDecay::kElec : log << "Electron-"; break;
-    case WDecay::kMuon : log << "Muon-"    ; break;
-    case WDecay::kTau  : log << "Tau-"     ; break;
-    default            : log << "Unknown-" ; break;
+  // get some information from the genEvent (if available);
+  // the product and the decay channel are resolved only once
+  const TtGenEvent* genEvt = genEventProduct();
+  if( !genEvt ) buffer += compact ? "\"genEvent\":null" : " TtGenEvent not available! \n";
+  else {
+    const char* decay = "";
+    bool fullLeptonic = false;
+    if( !genEvt->isTtBar() )            decay = "Not TtBar";
+    else if( genEvt->isFullHadronic() ) decay = "Fully Hadronic TtBar";
+    else if( genEvt->isSemiLeptonic() ) decay = "Semi-leptonic TtBar";
+    else if( genEvt->isFullLeptonic() ) {
+      decay = "Fully Leptonic TtBar";
+      fullLeptonic = true;
+    }
+    std::pair<WDecay::LeptonType, WDecay::LeptonType> channel(WDecay::kNone, WDecay::kNone);
+    if(fullLeptonic)
+      channel = genEvt->fullLeptonicChannel();
+    if(compact) {
+      dumpFormat(buffer, "\"genEvent\":{\"decay\":\"%s\"", decay);
+      if(fullLeptonic) dumpFormat(buffer, ",\"channel\":[\"%s\",\"%s\"]", lepDecayLabel(channel.first), lepDecayLabel(channel.second));
+      buffer += "}";
     }
-    switch( this->genEvent()->fullLeptonicChannel().second ) {
-    case WDecay::kElec : log << "Electron-"; break;
-    case WDecay::kMuon : log << "Muon-"    ; break;
-    case WDecay::kTau  : log << "Tau-"     ; break;
-    default            : log << "Unknown-" ; break;
+    else {
+      dumpFormat(buffer, " TtGenEvent says: %s", decay);
+      if(fullLeptonic) dumpFormat(buffer, ", %s-%s-Channel", lepDecayLabel(channel.first), lepDecayLabel(channel.second));
+      buffer += "\n";
     }
-    log << "Channel";
   }
-  log << "\n";
 
   // get number of available hypothesis classes
-  log << " Number of available event hypothesis classes: " << this->numberOfAvailableHypoClasses() << " \n";
-
-  // create a legend for the jetLepComb
-  log << " - JetLepComb: ";
-  log << "  b    ";
-  log << " bbar  ";
-  log << " e1(+) ";
-  log << " e2(-) ";
-  log << " mu1(+)";
-  log << " mu2(-)";
-  log << "\n";
+  if(compact) dumpFormat(buffer, ",\"numberOfAvailableHypoClasses\":%u,\"hypoClasses\":[", this->numberOfAvailableHypoClasses());
+  else {
+    dumpFormat(buffer, " Number of available event hypothesis classes: %u \n", this->numberOfAvailableHypoClasses());
+    // create a legend for the jetLepComb
+    buffer += " - JetLepComb:   b     bbar   e1(+)  e2(-)  mu1(+) mu2(-)\n";
+  }
 
   // get details from the hypotheses
-  typedef std::map<HypoClassKey, std::vector<HypoCombPair> >::const_iterator EventHypo;
-  for(EventHypo hyp = evtHyp_.begin(); hyp != evtHyp_.end(); ++hyp) {
-    HypoClassKey hypKey = (*hyp).first;
-    // header for each hypothesis
-    log << "------------------------------------------------------------ \n";
+  const std::vector<HypoClassId> hypoClassIds = availableHypoClasses();
+  for(std::vector<HypoClassId>::const_iterator hyp = hypoClassIds.begin(); hyp != hypoClassIds.end(); ++hyp) {
+    HypoClassId hypKey = *hyp;
+    const std::vector<reco::CompositeCandidate>& hypos = evtHyp_[hypKey];
+    // header for each hypothesis; classes registered at runtime are labeled by their name
+    const std::string name = hypKey > kHitFit ? TtHypoClassRegistry::name(hypKey) : std::string();
+    const char* label = 0;
+    bool applicable = false;
     switch(hypKey) {
-    case kGeom              : log << " Geom not (yet) applicable to TtFullLeptonicEvent --> skipping"             ; continue;
-    case kWMassMaxSumPt     : log << " WMassMaxSumPt not (yet) applicable to TtFullLeptonicEvent --> skipping"    ; continue;
-    case kMaxSumPtWMass     : log << " MaxSumPtWMass not (yet) applicable to TtFullLeptonicEvent --> skipping"    ; continue;
-    case kGenMatch          : log << " GenMatch"                                                                  ; break;
-    case kMVADisc           : log << " MVADisc not (yet) applicable to TtFullLeptonicEvent --> skipping"          ; continue;
-    case kKinFit            : log << " KinFit not (yet) applicable to TtFullLeptonicEvent --> skipping"           ; continue;
-    case kKinSolution       : log << " KinSolution"                                                               ; break;
-    case kWMassDeltaTopMass : log << " WMassDeltaTopMass not (yet) applicable to TtFullLeptonicEvent --> skipping"; continue;
-    case kHitFit            : log << " HitFit not (yet) applicable to TtFullLeptonicEvent --> skipping"           ; continue;
-    default                 : log << " Unknown TtEvent::HypoClassKey provided --> skipping"                       ; continue;
+    case kGeom              : label = "Geom"             ; break;
+    case kWMassMaxSumPt     : label = "WMassMaxSumPt"    ; break;
+    case kMaxSumPtWMass     : label = "MaxSumPtWMass"    ; break;
+    case kGenMatch          : label = "GenMatch"         ; applicable = true; break;
+    case kMVADisc           : label = "MVADisc"          ; break;
+    case kKinFit            : label = "KinFit"           ; break;
+    case kKinSolution       : label = "KinSolution"      ; applicable = true; break;
+    case kWMassDeltaTopMass : label = "WMassDeltaTopMass"; break;
+    case kHitFit            : label = "HitFit"           ; break;
+    default                 : label = name.c_str()       ; applicable = true; break;
+    }
+    if(compact) {
+      dumpFormat(buffer, "%s{\"key\":\"%s\"", hyp==hypoClassIds.begin() ? "" : ",", label);
+      if(!applicable) {
+	buffer += ",\"applicable\":false}";
+	continue;
+      }
     }
-    log << "-Hypothesis: \n";
-    unsigned nOfHyp = this->numberOfAvailableHypos(hypKey);
-    if(nOfHyp > 1) {
-      log << " * Number of available jet combinations: " << nOfHyp << "\n";
-      if(verbosity < 10)
-	log << " The following was found to be the best one:\n";
+    else {
+      buffer += "------------------------------------------------------------ \n";
+      if(!applicable) {
+	dumpFormat(buffer, " %s not (yet) applicable to TtFullLeptonicEvent --> skipping\n", label);
+	continue;
+      }
+    }
+    unsigned nOfHyp = hypos.size();
+    if(compact)
+      dumpFormat(buffer, ",\"numberOfAvailableHypos\":%u,\"hypos\":[", nOfHyp);
+    else {
+      dumpFormat(buffer, " %s-Hypothesis: \n", label);
+      if(nOfHyp > 1) {
+	dumpFormat(buffer, " * Number of available jet combinations: %u\n", nOfHyp);
+	if(verbosity < 10)
+	  buffer += " The following was found to be the best one:\n";
+      }
     }
     // if verbosity level is smaller than 10, never show more than the best jet combination
-    if(verbosity < 10)
+    if(verbosity < 10 && nOfHyp > 1)
       nOfHyp = 1;
     for(unsigned cmb=0; cmb<nOfHyp; cmb++) {
+      const reco::CompositeCandidate& hypo = hypos[cmb];
       // check if hypothesis is valid
-      if( !this->isHypoValid(hypKey, cmb) )
-	log << " * Not valid! \n";
+      if( hypo.roles().empty() ) {
+	if(compact) dumpFormat(buffer, "%s{\"cmb\":%u,\"valid\":false}", cmb==0 ? "" : ",", cmb);
+	else buffer += " * Not valid! \n";
+	continue;
+      }
       // get meta information for valid hypothesis
-      else {
-	// jetLepComb
-	log << " * JetLepComb:";
-	std::vector<int> jets = this->jetLeptonCombination(hypKey, cmb);
-	for(unsigned int iJet = 0; iJet < jets.size(); iJet++) {
-	  log << "   " << jets[iJet] << "   ";
+      if(compact) dumpFormat(buffer, "%s{\"cmb\":%u,\"valid\":true,", cmb==0 ? "" : ",", cmb);
+      else buffer += " * JetLepComb:";
+      dumpJetLeptonCombination(buffer, jetLepComb(hypKey, cmb), "   ", compact);
+      // specialties for some hypotheses
+      switch(hypKey) {
+      case kGenMatch    :
+	dumpFormat(buffer, compact ? ",\"genMatchSumDR\":%g,\"genMatchSumPt\":%g" : " * Sum(DeltaR) : %g \n * Sum(DeltaPt): %g \n",
+		   this->genMatchSumDR(cmb), this->genMatchSumPt(cmb)); break;
+      case kKinSolution :
+	dumpFormat(buffer, compact ? ",\"solWeight\":%g,\"isWrongCharge\":%d" : " * Weight      : %g \n * isWrongCharge: %d \n",
+		   this->solWeight(cmb), (int)this->isWrongCharge()); break;
+      default           : break;
+      }
+      // kinematic quantities of particles (if last digit of verbosity level > 1);
+      // the decay tree is walked once instead of once per accessor
+      if(verbosity%10 >= 2) {
+	const reco::Candidate* top    = hypo.daughter(TtFullLepDaughter::Top   );
+	const reco::Candidate* wPlus  = top    ? top   ->daughter(TtFullLepDaughter::WPlus ) : 0;
+	const reco::Candidate* topBar = hypo.daughter(TtFullLepDaughter::TopBar);
+	const reco::Candidate* wMinus = topBar ? topBar->daughter(TtFullLepDaughter::WMinus) : 0;
+	if(!compact) buffer += " * Candidates (pt; eta; phi; mass):\n";
+	const char* sep = compact ? "," : "";
+	if(verbosity%10 >= 3) {
+	  buffer += sep; dumpParticle(buffer, compact ? "topPair" : "top pair", &hypo, compact);
 	}
-	log << "\n";
-	// specialties for some hypotheses
-	switch(hypKey) {
-	case kGenMatch : log << " * Sum(DeltaR) : "     << this->genMatchSumDR(cmb) << " \n"
-			     << " * Sum(DeltaPt): "     << this->genMatchSumPt(cmb) << " \n"; break;
-	case kKinSolution : log << " * Weight      : "  << this->solWeight(cmb)     << " \n"
-				<< " * isWrongCharge: " << this->isWrongCharge()    << " \n"; break;
-	default        : break;
+	buffer += sep; dumpParticle(buffer, compact ? "top"   : "top         ", top  , compact);
+	buffer += sep; dumpParticle(buffer, compact ? "wPlus" : "W plus      ", wPlus, compact);
+	if(verbosity%10 >= 3) {
+	  buffer += sep; dumpParticle(buffer, compact ? "b"         : "b           ", top   ? top  ->daughter(TtFullLepDaughter::B     ) : 0, compact);
+	  buffer += sep; dumpParticle(buffer, compact ? "leptonBar" : "leptonBar   ", wPlus ? wPlus->daughter(TtFullLepDaughter::LepBar) : 0, compact);
+	  buffer += sep; dumpParticle(buffer, compact ? "neutrino"  : "neutrino    ", wPlus ? wPlus->daughter(TtFullLepDaughter::Nu    ) : 0, compact);
 	}
-	// kinematic quantities of particles (if last digit of verbosity level > 1)
-	if(verbosity%10 >= 2) {
-	  log << " * Candidates (pt; eta; phi; mass):\n";
-	  if(verbosity%10 >= 3)
-	    printParticle(log, "top pair", this->topPair(hypKey, cmb));
-	  printParticle(log, "top         ", this->top  (hypKey, cmb));
-	  printParticle(log, "W plus      ", this->wPlus(hypKey, cmb));
-	  if(verbosity%10 >= 3) {
-	    printParticle(log, "b           ", this->b        (hypKey, cmb));
-	    printParticle(log, "leptonBar   ", this->leptonBar(hypKey, cmb));
-	    printParticle(log, "neutrino    ", this->neutrino (hypKey, cmb));
-	  }
-	  printParticle(log, "topBar      ", this->topBar(hypKey, cmb));
-	  printParticle(log, "W minus     ", this->wMinus(hypKey, cmb));
-	  if(verbosity%10 >= 3) {
-	    printParticle(log, "bBar        ", this->bBar       (hypKey, cmb));
-	    printParticle(log, "lepton      ", this->lepton     (hypKey, cmb));
-	    printParticle(log, "neutrinoBar ", this->neutrinoBar(hypKey, cmb));
-	  }
+	buffer += sep; dumpParticle(buffer, compact ? "topBar" : "topBar      ", topBar, compact);
+	buffer += sep; dumpParticle(buffer, compact ? "wMinus" : "W minus     ", wMinus, compact);
+	if(verbosity%10 >= 3) {
+	  buffer += sep; dumpParticle(buffer, compact ? "bBar"        : "bBar        ", topBar ? topBar->daughter(TtFullLepDaughter::BBar ) : 0, compact);
+	  buffer += sep; dumpParticle(buffer, compact ? "lepton"      : "lepton      ", wMinus ? wMinus->daughter(TtFullLepDaughter::Lep  ) : 0, compact);
+	  buffer += sep; dumpParticle(buffer, compact ? "neutrinoBar" : "neutrinoBar ", wMinus ? wMinus->daughter(TtFullLepDaughter::NuBar) : 0, compact);
 	}
       }
+      if(compact) buffer += "}";
     }
+    if(compact) buffer += "]}";
   }
 
-  log << "+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
+  buffer += compact ? "]}" : "+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++";
+}
+
+void
+TtFullLeptonicEvent::systemCandidates(const reco::CompositeCandidate& hypo, const reco::Candidate*& top, const reco::Candidate*& topBar,
+				      const reco::Candidate*& leptonBar, const reco::Candidate*& lepton) const
+{
+  top    = hypo.daughter(TtFullLepDaughter::Top   );
+  topBar = hypo.daughter(TtFullLepDaughter::TopBar);
+  const reco::Candidate* wPlus  = top    ? top   ->daughter(TtFullLepDaughter::WPlus ) : 0;
+  const reco::Candidate* wMinus = topBar ? topBar->daughter(TtFullLepDaughter::WMinus) : 0;
+  leptonBar = wPlus  ? wPlus ->daughter(TtFullLepDaughter::LepBar) : 0;
+  lepton    = wMinus ? wMinus->daughter(TtFullLepDaughter::Lep   ) : 0;
 }
@@ -19,7 +19,7 @@ TtGenEvent::TtGenEvent(reco::GenParticleRefProd& decaySubset, reco::GenParticleR
 bool
 TtGenEvent::fromGluonFusion() const
 {
-  const reco::GenParticleCollection& initPartsColl = *initPartons_;
+  const reco::GenParticleCollection& initPartsColl = initialPartons();
   if(initPartsColl.size()==2)
     if(initPartsColl[0].pdgId()==21 && initPartsColl[1].pdgId()==21)
       return true;
@@ -29,7 +29,7 @@ TtGenEvent::fromGluonFusion() const
 bool
 TtGenEvent::fromQuarkAnnihilation() const
 {
-  const reco::GenParticleCollection& initPartsColl = *initPartons_;
+  const reco::GenParticleCollection& initPartsColl = initialPartons();
   if(initPartsColl.size()==2)
     if(std::abs(initPartsColl[0].pdgId())<TopDecayID::tID && initPartsColl[0].pdgId()==-initPartsColl[1].pdgId())
       return true;
@@ -67,100 +67,104 @@ TtGenEvent::fullLeptonicChannel() const
   return ( std::pair<WDecay::LeptonType,WDecay::LeptonType>(typeA, typeB) );
 }
 
-const reco::GenParticle* 
-TtGenEvent::lepton(bool excludeTauLeptons) const 
+namespace {
+  // electron or muon at the end of the decay chain of a tau; 0 for hadronic tau decays
+  const reco::GenParticle* visibleTauDaughter(const reco::Candidate& tau)
+  {
+    for(reco::Candidate::const_iterator d=tau.begin(); d!=tau.end(); ++d){
+      const int pdgId = std::abs(d->pdgId());
+      if( pdgId==TopDecayID::elecID || pdgId==TopDecayID::muonID )
+	return dynamic_cast<const reco::GenParticle*>(&(*d));
+      if( pdgId==TopDecayID::tauID )
+	return visibleTauDaughter(*d);
+    }
+    return 0;
+  }
+}
+
+const reco::GenParticle*
+TtGenEvent::leptonRole(LeptonRole role) const
 {
-  const reco::GenParticle* cand = 0;
-  const reco::GenParticleCollection& partsColl = *parts_;
+  if( !leptonsFlag_.isFilled() && leptonsFlag_.lock() ){
+    resolveLeptons(leptons_);
+    leptonsFlag_.setFilled();
+  }
+  if( leptonsFlag_.isFilled() )
+    return leptons_[role];
+  // the cache is being filled by another thread
+  const reco::GenParticle* leptons[kNumberOfLeptonRoles];
+  resolveLeptons(leptons);
+  return leptons[role];
+}
+
+void
+TtGenEvent::resolveLeptons(const reco::GenParticle* leptons[kNumberOfLeptonRoles]) const
+{
+  for(unsigned int r = 0; r < kNumberOfLeptonRoles; ++r)
+    leptons[r] = 0;
+  if( !parts_ )
+    return;
+  const reco::GenParticleCollection& partsColl = particles();
   for (unsigned int i = 0; i < partsColl.size(); ++i) {
-    if (reco::isLepton(partsColl[i]) && partsColl[i].mother() &&
-	std::abs(partsColl[i].mother()->pdgId())==TopDecayID::WID) {
-      if(reco::flavour(partsColl[i])>0){
-	cand = &partsColl[i];
-      }
-    }
+    const reco::GenParticle& part = partsColl[i];
+    if( !part.mother() || std::abs(part.mother()->pdgId())!=TopDecayID::WID )
+      continue;
+    if( reco::isLepton(part) )
+      leptons[reco::flavour(part)>0 ? kLepton : kLeptonBar] = &part;
+    else if( reco::isNeutrino(part) )
+      leptons[reco::flavour(part)>0 ? kNeutrino : kNeutrinoBar] = &part;
   }
-  return cand;
+  // follow the tau decays down to the visible electron or muon
+  leptons[kVisibleLepton   ] = leptons[kLepton   ] && std::abs(leptons[kLepton   ]->pdgId())==TopDecayID::tauID ? visibleTauDaughter(*leptons[kLepton   ]) : leptons[kLepton   ];
+  leptons[kVisibleLeptonBar] = leptons[kLeptonBar] && std::abs(leptons[kLeptonBar]->pdgId())==TopDecayID::tauID ? visibleTauDaughter(*leptons[kLeptonBar]) : leptons[kLeptonBar];
+}
+
+const reco::GenParticle* 
+TtGenEvent::lepton(bool excludeTauLeptons) const 
+{
+  const reco::GenParticle* cand = leptonRole(kLepton);
+  return (excludeTauLeptons && cand && std::abs(cand->pdgId())==TopDecayID::tauID) ? 0 : cand;
 }
 
 const reco::GenParticle* 
 TtGenEvent::leptonBar(bool excludeTauLeptons) const 
 {
-  const reco::GenParticle* cand = 0;
-  const reco::GenParticleCollection& partsColl = *parts_;
-  for (unsigned int i = 0; i < partsColl.size(); ++i) {
-    if (reco::isLepton(partsColl[i]) && partsColl[i].mother() &&
-	std::abs(partsColl[i].mother()->pdgId())==TopDecayID::WID) {
-      if(reco::flavour(partsColl[i])<0){
-	cand = &partsColl[i];
-      }
-    }
-  }
-  return cand;
+  const reco::GenParticle* cand = leptonRole(kLeptonBar);
+  return (excludeTauLeptons && cand && std::abs(cand->pdgId())==TopDecayID::tauID) ? 0 : cand;
 }
 
 const reco::GenParticle* 
 TtGenEvent::singleLepton(bool excludeTauLeptons) const 
 {
-  const reco::GenParticle* cand = 0;
-  if( isSemiLeptonic(excludeTauLeptons) ){
-    const reco::GenParticleCollection& partsColl = *parts_;
-    for (unsigned int i = 0; i < partsColl.size(); ++i) {
-      if (reco::isLepton(partsColl[i]) && partsColl[i].mother() &&
-	  std::abs(partsColl[i].mother()->pdgId())==TopDecayID::WID) {
-        cand = &partsColl[i];
-      }
-    }
-  }
-  return cand;
+  if( !isSemiLeptonic(excludeTauLeptons) )
+    return 0;
+  const reco::GenParticle* cand = lepton(excludeTauLeptons);
+  return cand ? cand : leptonBar(excludeTauLeptons);
 }
 
 const reco::GenParticle* 
 TtGenEvent::neutrino(bool excludeTauLeptons) const 
 {
-  const reco::GenParticle* cand=0;
-  const reco::GenParticleCollection & partsColl = *parts_;
-  for (unsigned int i = 0; i < partsColl.size(); ++i) {
-    if (reco::isNeutrino(partsColl[i]) && partsColl[i].mother() &&
-	std::abs(partsColl[i].mother()->pdgId())==TopDecayID::WID) {
-      if(reco::flavour(partsColl[i])>0){
-	cand = &partsColl[i];
-      }
-    }
-  }
-  return cand;
+  // the neutrino comes from the W+ together with the anti-lepton
+  const reco::GenParticle* cand = leptonRole(kNeutrino);
+  return (excludeTauLeptons && !leptonBar(true) && leptonRole(kLeptonBar)) ? 0 : cand;
 }
 
 const reco::GenParticle* 
 TtGenEvent::neutrinoBar(bool excludeTauLeptons) const 
 {
-  const reco::GenParticle* cand=0;
-  const reco::GenParticleCollection & partsColl = *parts_;
-  for (unsigned int i = 0; i < partsColl.size(); ++i) {
-    if (reco::isNeutrino(partsColl[i]) && partsColl[i].mother() &&
-	std::abs(partsColl[i].mother()->pdgId())==TopDecayID::WID) {
-      if(reco::flavour(partsColl[i])<0){
-	cand = &partsColl[i];
-      }
-    }
-  }
-  return cand;
+  // the anti-neutrino comes from the W- together with the lepton
+  const reco::GenParticle* cand = leptonRole(kNeutrinoBar);
+  return (excludeTauLeptons && !lepton(true) && leptonRole(kLepton)) ? 0 : cand;
 }
 
 const reco::GenParticle* 
 TtGenEvent::singleNeutrino(bool excludeTauLeptons) const 
 {
-  const reco::GenParticle* cand=0;
-  if( isSemiLeptonic(excludeTauLeptons) ) {
-    const reco::GenParticleCollection & partsColl = *parts_;
-    for (unsigned int i = 0; i < partsColl.size(); ++i) {
-      if (reco::isNeutrino(partsColl[i]) && partsColl[i].mother() &&
-	  std::abs(partsColl[i].mother()->pdgId())==TopDecayID::WID) {
-        cand = &partsColl[i];
-      }
-    }
-  }
-  return cand;
+  if( !isSemiLeptonic(excludeTauLeptons) )
+    return 0;
+  // take the neutrino of the W boson that decays into the single lepton
+  return lepton(excludeTauLeptons) ? neutrinoBar(excludeTauLeptons) : neutrino(excludeTauLeptons);
 }
 
 const reco::GenParticle* 
@@ -172,7 +176,8 @@ TtGenEvent::hadronicDecayQuark(bool invertFlavor) const
   // only makes sense if taus are not excluded from the 
   // decision
   if( singleLepton(false) ){
-    for(reco::GenParticleCollection::const_iterator w=parts_->begin(); w!=parts_->end(); ++w){
+    const reco::GenParticleCollection& partsColl = particles();
+    for(reco::GenParticleCollection::const_iterator w=partsColl.begin(); w!=partsColl.end(); ++w){
       if( std::abs( w->pdgId() )==TopDecayID::WID ){
 	// make sure that the particle is a W daughter
 	for(reco::GenParticle::const_iterator wd=w->begin(); wd!=w->end(); ++wd){ 
@@ -198,7 +203,7 @@ TtGenEvent::hadronicDecayB(bool excludeTauLeptons) const
 {
   const reco::GenParticle* cand=0;
   if( singleLepton(excludeTauLeptons) ){
-    const reco::GenParticleCollection& partsColl = *parts_;
+    const reco::GenParticleCollection& partsColl = particles();
     const reco::GenParticle& singleLep = *singleLepton(excludeTauLeptons);
     for (unsigned int i = 0; i < partsColl.size(); ++i) {
       if (std::abs(partsColl[i].pdgId())==TopDecayID::bID && 
@@ -215,7 +220,7 @@ TtGenEvent::hadronicDecayW(bool excludeTauLeptons) const
 {
   const reco::GenParticle* cand=0;
   if( singleLepton(excludeTauLeptons) ){
-    const reco::GenParticleCollection& partsColl = *parts_;
+    const reco::GenParticleCollection& partsColl = particles();
     const reco::GenParticle& singleLep = *singleLepton(excludeTauLeptons);
     for (unsigned int i = 0; i < partsColl.size(); ++i) {
       if (std::abs(partsColl[i].pdgId())==TopDecayID::WID && 
@@ -233,7 +238,7 @@ TtGenEvent::hadronicDecayTop(bool excludeTauLeptons) const
 {
   const reco::GenParticle* cand=0;
   if( singleLepton(excludeTauLeptons) ){
-    const reco::GenParticleCollection& partsColl = *parts_;
+    const reco::GenParticleCollection& partsColl = particles();
     const reco::GenParticle& singleLep = *singleLepton(excludeTauLeptons);
     for (unsigned int i = 0; i < partsColl.size(); ++i) {
       if (std::abs(partsColl[i].pdgId())==TopDecayID::tID &&
@@ -250,7 +255,7 @@ TtGenEvent::leptonicDecayB(bool excludeTauLeptons) const
 {
   const reco::GenParticle* cand=0;
   if( singleLepton(excludeTauLeptons) ){
-    const reco::GenParticleCollection& partsColl = *parts_;
+    const reco::GenParticleCollection& partsColl = particles();
     const reco::GenParticle& singleLep = *singleLepton(excludeTauLeptons);
     for (unsigned int i = 0; i < partsColl.size(); ++i) {
       if (std::abs(partsColl[i].pdgId())==TopDecayID::bID &&
@@ -267,7 +272,7 @@ TtGenEvent::leptonicDecayW(bool excludeTauLeptons) const
 {
   const reco::GenParticle* cand=0;
   if( singleLepton(excludeTauLeptons) ){
-    const reco::GenParticleCollection& partsColl = *parts_;
+    const reco::GenParticleCollection& partsColl = particles();
     const reco::GenParticle& singleLep = *singleLepton(excludeTauLeptons);
     for (unsigned int i = 0; i < partsColl.size(); ++i) {
       if (std::abs(partsColl[i].pdgId())==TopDecayID::WID &&
@@ -285,7 +290,7 @@ TtGenEvent::leptonicDecayTop(bool excludeTauLeptons) const
 {
   const reco::GenParticle* cand=0;
   if( singleLepton(excludeTauLeptons) ){
-    const reco::GenParticleCollection& partsColl = *parts_;
+    const reco::GenParticleCollection& partsColl = particles();
     const reco::GenParticle& singleLep = *singleLepton(excludeTauLeptons);
     for( unsigned int i = 0; i < partsColl.size(); ++i ){
       if( std::abs(partsColl[i].pdgId())==TopDecayID::tID &&
@@ -312,3 +317,32 @@ std::vector<const reco::GenParticle*> TtGenEvent::hadronicDecayTopRadiation(bool
   std::vector<const reco::GenParticle*> rad;
   return (rad);
 }
+
+TtSystemKinematics
+TtGenEvent::systemKinematics() const
+{
+  if(!systemKinematicsFlag_.isFilled() && systemKinematicsFlag_.lock()) {
+    computeSystemKinematics(systemKinematics_);
+    systemKinematicsFlag_.setFilled();
+  }
+  if(systemKinematicsFlag_.isFilled())
+    return systemKinematics_;
+  // the cache is being filled by another thread
+  TtSystemKinematics kinematics;
+  computeSystemKinematics(kinematics);
+  return kinematics;
+}
+
+void
+TtGenEvent::computeSystemKinematics(TtSystemKinematics& kinematics) const
+{
+  if(!isTtBar()) {
+    kinematics = TtSystemKinematics();
+    return;
+  }
+  const reco::GenParticle* lepBar = leptonBar();
+  const reco::GenParticle* lep = lepton();
+  const math::XYZTLorentzVector leptonBarP4 = lepBar ? math::XYZTLorentzVector(lepBar->p4()) : math::XYZTLorentzVector();
+  const math::XYZTLorentzVector leptonP4 = lep ? math::XYZTLorentzVector(lep->p4()) : math::XYZTLorentzVector();
+  kinematics.compute(top()->p4(), topBar()->p4(), lepBar ? &leptonBarP4 : 0, lep ? &leptonP4 : 0);
+}
@@ -140,45 +140,45 @@ pat::Jet TtHadEvtSolution::getHadk() const
 reco::Particle TtHadEvtSolution::getRecHadt() const 
 {
   // FIXME: the charge from the genevent
-  return reco::Particle(0,this->getRecHadp().p4()+this->getRecHadq().p4()+this->getRecHadb().p4());
+  return reco::Particle(0,this->getHadtP4(kRec));
 }
 
 reco::Particle TtHadEvtSolution::getRecHadtbar() const 
 {
   // FIXME: the charge from the genevent
-  return reco::Particle(0,this->getRecHadj().p4()+this->getRecHadk().p4()+this->getRecHadbbar().p4());
+  return reco::Particle(0,this->getHadtbarP4(kRec));
 }
 
 reco::Particle TtHadEvtSolution::getRecHadW_plus() const 
 {
   // FIXME: the charge from the genevent
-  return reco::Particle(0,this->getRecHadp().p4()+this->getRecHadq().p4());
+  return reco::Particle(0,this->getHadW_plusP4(kRec));
 }
 
 reco::Particle TtHadEvtSolution::getRecHadW_minus() const 
 {
   // FIXME: the charge from the genevent
-  return reco::Particle(0,this->getRecHadj().p4()+this->getRecHadk().p4());
+  return reco::Particle(0,this->getHadW_minusP4(kRec));
 }
 
 reco::Particle TtHadEvtSolution::getCalHadt() const 
 { 
-  return reco::Particle(0,this->getCalHadp().p4()+this->getCalHadq().p4()+this->getCalHadb().p4()); 
+  return reco::Particle(0,this->getHadtP4(kCal)); 
 }
 
 reco::Particle TtHadEvtSolution::getCalHadtbar() const 
 { 
-  return reco::Particle(0,this->getCalHadj().p4()+this->getCalHadk().p4()+this->getCalHadbbar().p4()); 
+  return reco::Particle(0,this->getHadtbarP4(kCal)); 
 }
 
 reco::Particle TtHadEvtSolution::getCalHadW_plus() const 
 { 
-  return reco::Particle(0,this->getCalHadp().p4()+this->getCalHadq().p4()); 
+  return reco::Particle(0,this->getHadW_plusP4(kCal)); 
 }
 
 reco::Particle TtHadEvtSolution::getCalHadW_minus() const 
 { 
-  return reco::Particle(0,this->getCalHadj().p4()+this->getCalHadk().p4()); 
+  return reco::Particle(0,this->getHadW_minusP4(kCal)); 
 }
 
 //-------------------------------------------
@@ -187,25 +187,73 @@ reco::Particle TtHadEvtSolution::getCalHadW_minus() const
 reco::Particle TtHadEvtSolution::getFitHadt() const 
 {
   // FIXME: provide the correct charge from generated event
-  return reco::Particle(0, this->getFitHadp().p4()+this->getFitHadq().p4()+this->getFitHadb().p4());
+  return reco::Particle(0, this->getHadtP4(kFit));
 }
 
 reco::Particle TtHadEvtSolution::getFitHadtbar() const 
 {
   // FIXME: provide the correct charge from generated event
-  return reco::Particle(0, this->getFitHadj().p4()+this->getFitHadk().p4()+this->getFitHadbbar().p4());
+  return reco::Particle(0, this->getHadtbarP4(kFit));
 }
 
 reco::Particle TtHadEvtSolution::getFitHadW_plus() const 
 {
   // FIXME: provide the correct charge from generated event
-  return reco::Particle(0, this->getFitHadp().p4()+this->getFitHadq().p4());
+  return reco::Particle(0, this->getHadW_plusP4(kFit));
 }
 
 reco::Particle TtHadEvtSolution::getFitHadW_minus() const 
 {
   // FIXME: provide the correct charge from generated event
-  return reco::Particle(0, this->getFitHadj().p4()+this->getFitHadk().p4());
+  return reco::Particle(0, this->getHadW_minusP4(kFit));
+}
+
+//-------------------------------------------
+// get four-vectors of the composites
+//-------------------------------------------
+math::XYZTLorentzVector TtHadEvtSolution::getHadtP4(P4Level level) const
+{
+  return getJetP4(hadp_, fitHadp_, "UDS", level) + getJetP4(hadq_, fitHadq_, "UDS", level) + getJetP4(hadb_, fitHadb_, "B", level);
+}
+
+math::XYZTLorentzVector TtHadEvtSolution::getHadtbarP4(P4Level level) const
+{
+  return getJetP4(hadj_, fitHadj_, "UDS", level) + getJetP4(hadk_, fitHadk_, "UDS", level) + getJetP4(hadbbar_, fitHadbbar_, "B", level);
+}
+
+math::XYZTLorentzVector TtHadEvtSolution::getHadW_plusP4(P4Level level) const
+{
+  return getJetP4(hadp_, fitHadp_, "UDS", level) + getJetP4(hadq_, fitHadq_, "UDS", level);
+}
+
+math::XYZTLorentzVector TtHadEvtSolution::getHadW_minusP4(P4Level level) const
+{
+  return getJetP4(hadj_, fitHadj_, "UDS", level) + getJetP4(hadk_, fitHadk_, "UDS", level);
+}
+
+void TtHadEvtSolution::getCompositeP4(CompositeP4& p4, P4Level level) const
+{
+  // every jet is resolved only once
+  p4.hadW_plus  = getJetP4(hadp_, fitHadp_, "UDS", level) + getJetP4(hadq_, fitHadq_, "UDS", level);
+  p4.hadW_minus = getJetP4(hadj_, fitHadj_, "UDS", level) + getJetP4(hadk_, fitHadk_, "UDS", level);
+  p4.hadt       = p4.hadW_plus  + getJetP4(hadb_,    fitHadb_,    "B", level);
+  p4.hadtbar    = p4.hadW_minus + getJetP4(hadbbar_, fitHadbbar_, "B", level);
+}
+
+math::XYZTLorentzVector TtHadEvtSolution::getJetP4(const edm::Ref<std::vector<pat::Jet> >& jet, const std::vector<pat::Particle>& fit,
+						   const char* flavor, P4Level level) const
+{
+  switch(level){
+  case kRec : 
+    return jet->correctedP4("RAW");
+  case kCal : 
+    // WARNING the jet correction schemes are obsolete 
+    // and only kept for backwards compatibility
+    if(jetCorrScheme_==1 || jetCorrScheme_==2) return jet->correctedP4("HAD", flavor);
+    return jet->p4();
+  default   : 
+    return fit.empty() ? math::XYZTLorentzVector() : math::XYZTLorentzVector(fit.front().p4());
+  }
 }
 
 //-------------------------------------------  
@@ -244,6 +292,7 @@ void TtHadEvtSolution::setGenEvt(const edm::Handle<TtGenEvent> & aGenEvt)
     return;
   }
   theGenEvt_ = edm::RefProd<TtGenEvent>(aGenEvt);
+  theGenEvtCache_.reset();
 }
 
 //-------------------------------------------
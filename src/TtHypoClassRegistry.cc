@@ -0,0 +1,146 @@
+#include "FWCore/Utilities/interface/Exception.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtHypoClassRegistry.h"
+
+namespace {
+  // names of the built-in hypothesis classes in the order of TtEvent::HypoClassKey
+  const char* const builtinHypoClasses[] = {"kGeom", "kWMassMaxSumPt", "kMaxSumPtWMass", "kGenMatch", "kMVADisc",
+					    "kKinFit", "kKinSolution", "kWMassDeltaTopMass", "kHitFit"};
+
+  // spin lock of the registry
+  volatile int registryLock = 0;
+}
+
+void
+TtHypoClassRegistry::lock()
+{
+  while(__sync_lock_test_and_set(&registryLock, 1))
+    while(registryLock) ;
+}
+
+void
+TtHypoClassRegistry::unlock()
+{
+  __sync_lock_release(&registryLock);
+}
+
+const TtHypoClassRegistry::Snapshot*&
+TtHypoClassRegistry::current()
+{
+  static const Snapshot* current = 0;
+  return current;
+}
+
+const TtHypoClassRegistry::Snapshot&
+TtHypoClassRegistry::snapshot()
+{
+  const Snapshot* snapshot = __atomic_load_n(&current(), __ATOMIC_ACQUIRE);
+  if(snapshot)
+    return *snapshot;
+  // the built-in classes are published on first use
+  lock();
+  if(!current()){
+    Snapshot* builtins = new Snapshot;
+    for(unsigned int i=0; i<sizeof(builtinHypoClasses)/sizeof(builtinHypoClasses[0]); ++i)
+      add(*builtins, builtinHypoClasses[i]);
+    publish(builtins);
+  }
+  snapshot = current();
+  unlock();
+  return *snapshot;
+}
+
+void
+TtHypoClassRegistry::publish(const Snapshot* snapshot)
+{
+  // the replaced snapshot is not deleted, concurrent lookups may still read it
+  __atomic_store_n(&current(), snapshot, __ATOMIC_RELEASE);
+}
+
+unsigned int
+TtHypoClassRegistry::add(Snapshot& snapshot, const std::string& name)
+{
+  std::map<std::string, unsigned int>::const_iterator id = snapshot.ids.find(name);
+  if(id!=snapshot.ids.end())
+    return id->second;
+  snapshot.ids[name] = snapshot.names.size();
+  snapshot.names.push_back(name);
+  return snapshot.names.size()-1;
+}
+
+unsigned int
+TtHypoClassRegistry::registerHypoClass(const std::string& name)
+{
+  if(name.empty())
+    throw cms::Exception("Configuration") << "Hypothesis classes need a name.\n";
+  // registered classes are found without locking
+  const int known = find(name);
+  if(known>=0)
+    return known;
+  snapshot();
+  lock();
+  Snapshot* updated = new Snapshot(*current());
+  const unsigned int id = add(*updated, name);
+  // another thread may have registered the class meanwhile
+  if(updated->names.size()==current()->names.size())
+    delete updated;
+  else
+    publish(updated);
+  unlock();
+  return id;
+}
+
+int
+TtHypoClassRegistry::find(const std::string& name)
+{
+  const Snapshot& known = snapshot();
+  std::map<std::string, unsigned int>::const_iterator id = known.ids.find(name);
+  return (id==known.ids.end() ? -1 : (int)id->second);
+}
+
+unsigned int
+TtHypoClassRegistry::id(const std::string& name)
+{
+  const int id = find(name);
+  if(id<0)
+    throw cms::Exception("Configuration") << "Hypothesis class '" << name << "' is not registered.\n";
+  return id;
+}
+
+std::string
+TtHypoClassRegistry::name(const unsigned int id)
+{
+  const Snapshot& known = snapshot();
+  if(id>=known.names.size())
+    throw cms::Exception("LogicError") << "No hypothesis class registered with ID " << id << ".\n";
+  return known.names[id];
+}
+
+unsigned int
+TtHypoClassRegistry::size()
+{
+  return snapshot().names.size();
+}
+
+TtHypoClassTable
+TtHypoClassRegistry::table()
+{
+  return TtHypoClassTable(snapshot().names);
+}
+
+std::vector<unsigned int>
+TtHypoClassRegistry::import(const TtHypoClassTable& table)
+{
+  std::vector<unsigned int> translation(table.size());
+  snapshot();
+  // one new snapshot for all classes of the table
+  lock();
+  Snapshot* updated = new Snapshot(*current());
+  for(unsigned int i=0; i<table.size(); ++i)
+    translation[i] = add(*updated, table.name(i));
+  if(updated->names.size()==current()->names.size())
+    delete updated;
+  else
+    publish(updated);
+  unlock();
+  return translation;
+}
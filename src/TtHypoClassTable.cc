@@ -0,0 +1,30 @@
+#include "AnalysisDataFormats/TopObjects/interface/TtHypoClassTable.h"
+
+#include <algorithm>
+
+int
+TtHypoClassTable::id(const std::string& name) const
+{
+  for(unsigned int i=0; i<names_.size(); ++i)
+    if(names_[i]==name) return i;
+  return -1;
+}
+
+bool
+TtHypoClassTable::isCompatible(const TtHypoClassTable& other) const
+{
+  const unsigned int n = std::min(names_.size(), other.names_.size());
+  for(unsigned int i=0; i<n; ++i)
+    if(names_[i]!=other.names_[i]) return false;
+  return true;
+}
+
+bool
+TtHypoClassTable::mergeProduct(const TtHypoClassTable& other)
+{
+  if(!isCompatible(other))
+    return false;
+  if(other.names_.size()>names_.size())
+    names_ = other.names_;
+  return true;
+}
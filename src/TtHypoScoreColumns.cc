@@ -0,0 +1,152 @@
+#include "FWCore/Utilities/interface/Exception.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtHypoScoreColumns.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtHypoScoreRegistry.h"
+
+namespace {
+  // returned for scores that are not available
+  const std::vector<double> noDoubles;
+  const std::vector<float> noFloats;
+  const std::vector<int> noInts;
+}
+
+int
+TtHypoScoreColumns::find(const unsigned int hypoClass, const std::string& name) const
+{
+  for(unsigned int column=0; column<names_.size(); ++column)
+    if(hypoClasses_[column]==hypoClass && names_[column]==name)
+      return column;
+  return -1;
+}
+
+int
+TtHypoScoreColumns::column(const unsigned int id) const
+{
+  if(!indexFlag_.isFilled() && indexFlag_.lock()) {
+    buildIndex();
+    indexFlag_.setFilled();
+  }
+  if(indexFlag_.isFilled() && id<index_.size())
+    return index_[id];
+  // scores registered after the index was built (and lookups racing with the first one)
+  if(id>=TtHypoScoreRegistry::size())
+    return -1;
+  unsigned int hypoClass;
+  std::string name;
+  TtHypoScoreRegistry::score(id, hypoClass, name);
+  return find(hypoClass, name);
+}
+
+unsigned int
+TtHypoScoreColumns::add(const unsigned int hypoClass, const std::string& name, const ValueType type)
+{
+  const int known = find(hypoClass, name);
+  if(known>=0) {
+    if(types_[known]!=type)
+      throw cms::Exception("Configuration") << "Score '" << name << "' of hypothesis class " << hypoClass
+					    << " is already available with another type of values.\n";
+    return known;
+  }
+  const unsigned int id = TtHypoScoreRegistry::registerScore(hypoClass, name);
+  // the index is only extended by scores it covers, newly registered ones need a rebuild
+  if(indexFlag_.isFilled() && id<index_.size())
+    index_[id] = names_.size();
+  else
+    resetIndex();
+  names_.push_back(name);
+  hypoClasses_.push_back(hypoClass);
+  types_.push_back(type);
+  switch(type) {
+  case kDouble : slots_.push_back(doubles_.size()); doubles_.resize(doubles_.size()+1); break;
+  case kFloat  : slots_.push_back(floats_.size());  floats_.resize(floats_.size()+1);   break;
+  case kInt    : slots_.push_back(ints_.size());    ints_.resize(ints_.size()+1);       break;
+  }
+  return names_.size()-1;
+}
+
+unsigned int
+TtHypoScoreColumns::add(const unsigned int id, const ValueType type)
+{
+  const int known = column(id);
+  if(known>=0 && types_[known]==type)
+    return known;
+  // unknown columns and type mismatches are handled as above
+  unsigned int hypoClass;
+  std::string name;
+  TtHypoScoreRegistry::score(id, hypoClass, name);
+  return add(hypoClass, name, type);
+}
+
+unsigned int
+TtHypoScoreColumns::numberOfValues(const unsigned int column) const
+{
+  switch(valueType(column)) {
+  case kDouble : return doubles_[slots_[column]].size();
+  case kFloat  : return floats_[slots_[column]].size();
+  case kInt    : return ints_[slots_[column]].size();
+  }
+  return 0;
+}
+
+double
+TtHypoScoreColumns::value(const unsigned int column, const unsigned int row, const double noValue) const
+{
+  if(column>=names_.size() || row>=numberOfValues(column))
+    return noValue;
+  switch(valueType(column)) {
+  case kDouble : return doubles_[slots_[column]][row];
+  case kFloat  : return floats_[slots_[column]][row];
+  case kInt    : return ints_[slots_[column]][row];
+  }
+  return noValue;
+}
+
+void
+TtHypoScoreColumns::remapHypoClasses(const std::vector<unsigned int>& translation)
+{
+  for(unsigned int column=0; column<hypoClasses_.size(); ++column)
+    if(hypoClasses_[column]<translation.size()) hypoClasses_[column] = translation[hypoClasses_[column]];
+  resetIndex();
+}
+
+void
+TtHypoScoreColumns::clear()
+{
+  names_.clear();
+  hypoClasses_.clear();
+  types_.clear();
+  slots_.clear();
+  doubles_.clear();
+  floats_.clear();
+  ints_.clear();
+  resetIndex();
+}
+
+void
+TtHypoScoreColumns::swap(TtHypoScoreColumns& other)
+{
+  names_.swap(other.names_);
+  hypoClasses_.swap(other.hypoClasses_);
+  types_.swap(other.types_);
+  slots_.swap(other.slots_);
+  doubles_.swap(other.doubles_);
+  floats_.swap(other.floats_);
+  ints_.swap(other.ints_);
+  resetIndex();
+  other.resetIndex();
+}
+
+void
+TtHypoScoreColumns::buildIndex() const
+{
+  // the index covers all scores registered up to here; later ones are looked up by name
+  index_.assign(TtHypoScoreRegistry::size(), -1);
+  for(unsigned int column=0; column<names_.size(); ++column) {
+    const int id = TtHypoScoreRegistry::find(hypoClasses_[column], names_[column]);
+    if(id>=0 && (unsigned int)id<index_.size())
+      index_[id] = column;
+  }
+}
+
+const std::vector<double>& TtHypoScoreColumns::noValues(const double*) { return noDoubles; }
+const std::vector<float>& TtHypoScoreColumns::noValues(const float*) { return noFloats; }
+const std::vector<int>& TtHypoScoreColumns::noValues(const int*) { return noInts; }
@@ -0,0 +1,108 @@
+#include "FWCore/Utilities/interface/Exception.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtHypoScoreRegistry.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtEvent.h"
+
+namespace {
+  // spin lock of the registry
+  volatile int registryLock = 0;
+}
+
+void
+TtHypoScoreRegistry::lock()
+{
+  while(__sync_lock_test_and_set(&registryLock, 1))
+    while(registryLock) ;
+}
+
+void
+TtHypoScoreRegistry::unlock()
+{
+  __sync_lock_release(&registryLock);
+}
+
+const TtHypoScoreRegistry::Snapshot*&
+TtHypoScoreRegistry::current()
+{
+  static const Snapshot* current = 0;
+  return current;
+}
+
+const TtHypoScoreRegistry::Snapshot&
+TtHypoScoreRegistry::snapshot()
+{
+  const Snapshot* snapshot = __atomic_load_n(&current(), __ATOMIC_ACQUIRE);
+  if(snapshot)
+    return *snapshot;
+  // the built-in scores are published on first use
+  lock();
+  if(!current()){
+    Snapshot* builtins = new Snapshot;
+    for(unsigned int key=0; key<=TtEvent::kMvaDiscScore; ++key){
+      const TtEvent::HypoScoreKey score = (TtEvent::HypoScoreKey)key;
+      builtins->scores.push_back(std::make_pair(TtEvent::scoreHypoClass(score), std::string(TtEvent::scoreName(score))));
+      builtins->ids[builtins->scores.back()] = key;
+    }
+    publish(builtins);
+  }
+  snapshot = current();
+  unlock();
+  return *snapshot;
+}
+
+void
+TtHypoScoreRegistry::publish(const Snapshot* snapshot)
+{
+  // the replaced snapshot is not deleted, concurrent lookups may still read it
+  __atomic_store_n(&current(), snapshot, __ATOMIC_RELEASE);
+}
+
+unsigned int
+TtHypoScoreRegistry::registerScore(const unsigned int hypoClass, const std::string& name)
+{
+  if(name.empty())
+    throw cms::Exception("Configuration") << "Scores need a name.\n";
+  // registered scores are found without locking
+  const int known = find(hypoClass, name);
+  if(known>=0)
+    return known;
+  const std::pair<unsigned int, std::string> score(hypoClass, name);
+  snapshot();
+  lock();
+  // another thread may have registered the score meanwhile
+  std::map<std::pair<unsigned int, std::string>, unsigned int>::const_iterator id = current()->ids.find(score);
+  unsigned int result;
+  if(id!=current()->ids.end())
+    result = id->second;
+  else {
+    Snapshot* updated = new Snapshot(*current());
+    result = updated->ids[score] = updated->scores.size();
+    updated->scores.push_back(score);
+    publish(updated);
+  }
+  unlock();
+  return result;
+}
+
+int
+TtHypoScoreRegistry::find(const unsigned int hypoClass, const std::string& name)
+{
+  const Snapshot& known = snapshot();
+  std::map<std::pair<unsigned int, std::string>, unsigned int>::const_iterator id = known.ids.find(std::make_pair(hypoClass, name));
+  return (id==known.ids.end() ? -1 : (int)id->second);
+}
+
+void
+TtHypoScoreRegistry::score(const unsigned int id, unsigned int& hypoClass, std::string& name)
+{
+  const Snapshot& known = snapshot();
+  if(id>=known.scores.size())
+    throw cms::Exception("LogicError") << "No score registered with ID " << id << ".\n";
+  hypoClass = known.scores[id].first;
+  name = known.scores[id].second;
+}
+
+unsigned int
+TtHypoScoreRegistry::size()
+{
+  return snapshot().scores.size();
+}
@@ -0,0 +1,42 @@
+#include "FWCore/Utilities/interface/Exception.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtJetLepComb.h"
+
+#include <algorithm>
+#include <limits>
+
+bool
+TtJetLepCombView::operator==(const TtJetLepCombView& rhs) const
+{
+  return size()==rhs.size() && std::equal(begin_, end_, rhs.begin_);
+}
+
+bool
+TtJetLepCombView::operator==(const std::vector<int>& rhs) const
+{
+  if(size()!=rhs.size())
+    return false;
+  for(unsigned int i=0; i<rhs.size(); ++i)
+    if(begin_[i]!=rhs[i]) return false;
+  return true;
+}
+
+TtJetLepCombView
+TtJetLepCombBuffer::operator[](const unsigned int i) const
+{
+  if(indices_.empty())
+    return TtJetLepCombView();
+  const short* data = &indices_[0];
+  return TtJetLepCombView(data+(i==0 ? 0 : ends_[i-1]), data+ends_[i]);
+}
+
+void
+TtJetLepCombBuffer::push_back(const std::vector<int>& comb)
+{
+  // the indices are stored as short
+  for(unsigned int i=0; i<comb.size(); ++i)
+    if(comb[i]<std::numeric_limits<short>::min() || comb[i]>std::numeric_limits<short>::max())
+      throw cms::Exception("Configuration") << "Jet lepton combination index " << comb[i] << " is out of the range of "
+					    << std::numeric_limits<short>::min() << " to " << std::numeric_limits<short>::max() << ".\n";
+  indices_.insert(indices_.end(), comb.begin(), comb.end());
+  ends_.push_back(indices_.size());
+}
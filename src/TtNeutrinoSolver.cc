@@ -0,0 +1,75 @@
+#include "AnalysisDataFormats/TopObjects/interface/TtNeutrinoSolver.h"
+
+#include <cmath>
+
+void
+TtNeutrinoSolver::clear()
+{
+  lepPx_.clear(); lepPy_.clear(); lepPz_.clear(); lepE_.clear();
+  nuPx_.clear(); nuPy_.clear();
+  pz_.clear(); pzOther_.clear(); scale_.clear(); nReal_.clear();
+}
+
+void
+TtNeutrinoSolver::reserve(const unsigned int n)
+{
+  lepPx_.reserve(n); lepPy_.reserve(n); lepPz_.reserve(n); lepE_.reserve(n);
+  nuPx_.reserve(n); nuPy_.reserve(n);
+}
+
+unsigned int
+TtNeutrinoSolver::add(const math::XYZTLorentzVector& lepton, const math::XYZTLorentzVector& met)
+{
+  lepPx_.push_back(lepton.px());
+  lepPy_.push_back(lepton.py());
+  lepPz_.push_back(lepton.pz());
+  lepE_ .push_back(lepton.energy());
+  nuPx_ .push_back(met.px());
+  nuPy_ .push_back(met.py());
+  return size()-1;
+}
+
+void
+TtNeutrinoSolver::solve()
+{
+  const unsigned int n = size();
+  pz_.resize(n); pzOther_.resize(n); scale_.assign(n, 1.); nReal_.resize(n);
+  for(unsigned int i=0; i<n; ++i) {
+    // with the W mass constraint the neutrino pz solves A*pz^2 + B*pz + C = 0, where
+    // A = E^2-pz_l^2, B = -2*mu*pz_l and C = E^2*pt_nu^2-mu^2 with the abbreviation
+    // mu = (mW^2-m_l^2)/2 + pt_l*pt_nu; the discriminant is 4*E^2*(mu^2-A*pt_nu^2)
+    const double lepE = lepE_[i], lepPz = lepPz_[i];
+    const double a    = lepE*lepE-lepPz*lepPz;
+    const double m2   = a-lepPx_[i]*lepPx_[i]-lepPy_[i]*lepPy_[i];
+    const double m    = 0.5*(wMass_*wMass_-m2);
+    const double d    = lepPx_[i]*nuPx_[i]+lepPy_[i]*nuPy_[i];
+    const double nuPt2= nuPx_[i]*nuPx_[i]+nuPy_[i]*nuPy_[i];
+    double mu   = m+d;
+    double disc = mu*mu-a*nuPt2;
+    nReal_[i] = disc>0 ? 2 : (disc==0 ? 1 : 0);
+    if(disc<0) {
+      if(policy_==kRescaleMET) {
+	// the largest scale factor s of the MET for which the discriminant vanishes
+	// is s = m/(sqrt(A)*pt_nu-pt_l*pt_nu); it is smaller than 1 here
+	scale_[i] = m/(std::sqrt(a*nuPt2)-d);
+	mu = m+scale_[i]*d;
+      }
+      disc = 0;
+    }
+    // of two real solutions the one with the smaller |pz| is chosen
+    const double root = lepE*std::sqrt(disc);
+    const double pz1 = (mu*lepPz+root)/a, pz2 = (mu*lepPz-root)/a;
+    const bool first = std::fabs(pz1)<std::fabs(pz2);
+    pz_     [i] = first ? pz1 : pz2;
+    pzOther_[i] = first ? pz2 : pz1;
+  }
+}
+
+math::XYZTLorentzVector
+TtNeutrinoSolver::neutrino(const unsigned int i, const unsigned int solution) const
+{
+  if(!isValid(i))
+    return math::XYZTLorentzVector();
+  const double px = scale_[i]*nuPx_[i], py = scale_[i]*nuPy_[i], pz = this->pz(i, solution);
+  return math::XYZTLorentzVector(px, py, pz, std::sqrt(px*px+py*py+pz*pz));
+}
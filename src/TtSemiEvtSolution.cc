@@ -12,6 +12,7 @@ TtSemiEvtSolution::TtSemiEvtSolution() :
   recoHyp_("ttSemiEvtRecoHyp"),
   fitHyp_ ("ttSemiEvtFitHyp")
 {
+  lepType_           = WDecay::kNone;
   jetCorrScheme_     = 0;
   sumAnglejp_        = -999.;
   angleHadp_         = -999.;
@@ -78,59 +79,47 @@ pat::Jet TtSemiEvtSolution::getLepb() const
 reco::Particle TtSemiEvtSolution::getRecHadt() const 
 {
   // FIXME: the charge from the genevent
-  return reco::Particle(0,this->getRecHadp().p4() + this->getRecHadq().p4() + this->getRecHadb().p4());
+  return reco::Particle(0,this->getHadtP4(kRec));
 }
 
 reco::Particle TtSemiEvtSolution::getRecHadW() const 
 {
   // FIXME: the charge from the genevent
-  return reco::Particle(0,this->getRecHadp().p4() + this->getRecHadq().p4());
+  return reco::Particle(0,this->getHadWP4(kRec));
 }
 
 reco::Particle TtSemiEvtSolution::getRecLept() const 
 {
   // FIXME: the charge from the genevent
-  reco::Particle p;
-  if (this->getDecay() == "muon")     p = reco::Particle(0,this->getRecLepm().p4() + this->getRecLepn().p4() + this->getRecLepb().p4());
-  if (this->getDecay() == "electron") p = reco::Particle(0,this->getRecLepe().p4() + this->getRecLepn().p4() + this->getRecLepb().p4());
-  return p;
+  return reco::Particle(0,this->getLeptP4(kRec));
 }
 
 reco::Particle TtSemiEvtSolution::getRecLepW() const 
 { 
   // FIXME: the charge from the genevent
-  reco::Particle p;
-  if (this->getDecay() == "muon")     p = reco::Particle(0,this->getRecLepm().p4() + this->getRecLepn().p4());
-  if (this->getDecay() == "electron") p = reco::Particle(0,this->getRecLepe().p4() + this->getRecLepn().p4());
-  return p;
+  return reco::Particle(0,this->getLepWP4(kRec));
 }
 
 // FIXME: Why these functions??? Not needed!
   // methods to get calibrated objects 
 reco::Particle TtSemiEvtSolution::getCalHadt() const 
 { 
-  return reco::Particle(0,this->getCalHadp().p4() + this->getCalHadq().p4() + this->getCalHadb().p4()); 
+  return reco::Particle(0,this->getHadtP4(kCal)); 
 }
 
 reco::Particle TtSemiEvtSolution::getCalHadW() const 
 { 
-  return reco::Particle(0,this->getCalHadp().p4() + this->getCalHadq().p4()); 
+  return reco::Particle(0,this->getHadWP4(kCal)); 
 }
 
 reco::Particle TtSemiEvtSolution::getCalLept() const 
 {
-  reco::Particle p;
-  if (this->getDecay() == "muon")     p = reco::Particle(0,this->getRecLepm().p4() + this->getRecLepn().p4() + this->getCalLepb().p4());
-  if (this->getDecay() == "electron") p = reco::Particle(0,this->getRecLepe().p4() + this->getRecLepn().p4() + this->getCalLepb().p4());
-  return p;
+  return reco::Particle(0,this->getLeptP4(kCal));
 }
 
 reco::Particle TtSemiEvtSolution::getCalLepW() const 
 {
-  reco::Particle p;
-  if (this->getDecay() == "muon")     p = reco::Particle(0,this->getRecLepm().p4() + this->getRecLepn().p4());
-  if (this->getDecay() == "electron") p = reco::Particle(0,this->getRecLepe().p4() + this->getRecLepn().p4());
-  return p;
+  return reco::Particle(0,this->getLepWP4(kCal));
 }
 
 //-------------------------------------------
@@ -139,25 +128,82 @@ reco::Particle TtSemiEvtSolution::getCalLepW() const
 reco::Particle TtSemiEvtSolution::getFitHadt() const 
 {
   // FIXME: provide the correct charge from generated event
-  return reco::Particle(0, this->getFitHadp().p4() + this->getFitHadq().p4() + this->getFitHadb().p4());
+  return reco::Particle(0, this->getHadtP4(kFit));
 }
 
 reco::Particle TtSemiEvtSolution::getFitHadW() const 
 {
   // FIXME: provide the correct charge from generated event
-  return reco::Particle(0, this->getFitHadp().p4() + this->getFitHadq().p4());
+  return reco::Particle(0, this->getHadWP4(kFit));
 }
 
 reco::Particle TtSemiEvtSolution::getFitLept() const 
 { 
   // FIXME: provide the correct charge from generated event
-  return reco::Particle(0, this->getFitLepl().p4() + this->getFitLepn().p4() + this->getFitLepb().p4());
+  return reco::Particle(0, this->getLeptP4(kFit));
 }
 
 reco::Particle TtSemiEvtSolution::getFitLepW() const 
 { 
   // FIXME: provide the correct charge from generated event
-  return reco::Particle(0, this->getFitLepl().p4() + this->getFitLepn().p4());
+  return reco::Particle(0, this->getLepWP4(kFit));
+}
+
+//-------------------------------------------
+// get four-vectors of the composites
+//-------------------------------------------
+math::XYZTLorentzVector TtSemiEvtSolution::getHadtP4(P4Level level) const
+{
+  return getHadWP4(level) + getJetP4(hadb_, fitHadb_, "B", level);
+}
+
+math::XYZTLorentzVector TtSemiEvtSolution::getHadWP4(P4Level level) const
+{
+  return getJetP4(hadp_, fitHadp_, "UDS", level) + getJetP4(hadq_, fitHadq_, "UDS", level);
+}
+
+math::XYZTLorentzVector TtSemiEvtSolution::getLeptP4(P4Level level) const
+{
+  // an undefined decay channel yields an empty four-vector
+  if(level!=kFit && lepType_!=WDecay::kMuon && lepType_!=WDecay::kElec) return math::XYZTLorentzVector();
+  return getLepWP4(level) + getJetP4(lepb_, fitLepb_, "B", level);
+}
+
+math::XYZTLorentzVector TtSemiEvtSolution::getLepWP4(P4Level level) const
+{
+  if(level==kFit)
+    return getFitP4(fitLepl_) + getFitP4(fitLepn_);
+  switch(lepType_){
+  case WDecay::kMuon : return math::XYZTLorentzVector(muon_    ->p4()) + math::XYZTLorentzVector(neutrino_->p4());
+  case WDecay::kElec : return math::XYZTLorentzVector(electron_->p4()) + math::XYZTLorentzVector(neutrino_->p4());
+  default : return math::XYZTLorentzVector();
+  }
+}
+
+void TtSemiEvtSolution::getCompositeP4(CompositeP4& p4, P4Level level) const
+{
+  // every jet and lepton is resolved only once
+  p4.hadW = getHadWP4(level);
+  p4.hadt = p4.hadW + getJetP4(hadb_, fitHadb_, "B", level);
+  p4.lepW = getLepWP4(level);
+  p4.lept = (level!=kFit && lepType_!=WDecay::kMuon && lepType_!=WDecay::kElec) ? math::XYZTLorentzVector() : 
+    p4.lepW + getJetP4(lepb_, fitLepb_, "B", level);
+}
+
+math::XYZTLorentzVector TtSemiEvtSolution::getJetP4(const edm::Ptr<pat::Jet>& jet, const std::vector<pat::Particle>& fit,
+						    const char* flavor, P4Level level) const
+{
+  switch(level){
+  case kRec : 
+    return jet->correctedP4("RAW");
+  case kCal : 
+    // WARNING the jet correction schemes are obsolete 
+    // and only kept for backwards compatibility
+    if(jetCorrScheme_==1 || jetCorrScheme_==2) return jet->correctedP4("HAD", flavor);
+    return jet->p4();
+  default   : 
+    return getFitP4(fit);
+  }
 }
 
 //-------------------------------------------
@@ -195,6 +241,7 @@ void TtSemiEvtSolution::setGenEvt(const edm::Handle<TtGenEvent> & aGenEvt)
     return;
   }
   theGenEvt_ = edm::RefProd<TtGenEvent>(aGenEvt);
+  theGenEvtCache_.reset();
 }
 
 //-------------------------------------------  
@@ -260,11 +307,11 @@ void TtSemiEvtSolution::setupHyp()
   addFourMomenta.set( recHadt );
   
   recLepW.addDaughter( neutrino,"neutrino" );
-  if ( getDecay() == "electron" ) {
+  if ( lepType_ == WDecay::kElec ) {
     reco::ShallowClonePtrCandidate electron ( electron_, electron_->charge(), electron_->p4(), electron_->vertex() );
 //     ElectronCandRef electron ( electron_->p4(), electron_->charge(), electron_->vertex() ); electron.setRef( electron_ );
     recLepW.addDaughter ( electron, "electron" );
-  } else if ( getDecay() == "muon" ) {
+  } else if ( lepType_ == WDecay::kMuon ) {
     reco::ShallowClonePtrCandidate muon ( muon_, muon_->charge(),  muon_->p4(), muon_->vertex() );
 //     MuonCandRef muon ( muon_->p4(), muon_->charge(), muon_->vertex() ); muon.setRef( muon_ );
     recLepW.addDaughter ( muon, "muon" );
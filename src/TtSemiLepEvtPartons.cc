@@ -17,6 +17,9 @@ TtSemiLepEvtPartons::TtSemiLepEvtPartons(const std::vector<std::string>& partons
     else throw cms::Exception("Configuration")
       << "The following string in partonsToIgnore is not supported: " << (*str) << "\n";
   }
+  // the light quarks of the hadronic W are interchangeable
+  const unsigned int swapQ[] = { LightQBar, LightQ, HadB, LepB };
+  symmetries_.push_back(std::vector<unsigned int>(swapQ, swapQ+4));
 }
 
 std::vector<const reco::Candidate*>
@@ -1,6 +1,5 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "AnalysisDataFormats/TopObjects/interface/TtSemiLeptonicEvent.h"
-#include "AnalysisDataFormats/TopObjects/interface/TtSemiLepEvtPartons.h"
 
 // print info via MessageLogger
 void
@@ -9,125 +8,198 @@ TtSemiLeptonicEvent::print(const int verbosity) const
   if(verbosity%10 <= 0)
     return;
 
-  edm::LogInfo log("TtSemiLeptonicEvent");
+  std::string buffer;
+  buffer.reserve(4096);
+  dump(buffer, verbosity);
+  edm::LogInfo("TtSemiLeptonicEvent") << buffer;
+}
+
+// format the content of the structure into a dump buffer
+void
+TtSemiLeptonicEvent::dump(std::string& buffer, const int verbosity, const bool compact) const
+{
+  buffer.clear();
+  if(verbosity%10 <= 0)
+    return;
 
-  log << "++++++++++++++++++++++++++++++++++++++++++++++++++ \n";
+  buffer += compact ? "{" : "++++++++++++++++++++++++++++++++++++++++++++++++++ \n";
 
-  // get some information from the genEvent (if available)
-  if( !genEvt_ ) log << " TtGenEvent not available! \n";
+  // get some information from the genEvent (if available);
+  // the product is resolved only once for the whole dump
+  const TtGenEvent* genEvt = genEventProduct();
+  if( !genEvt ) buffer += compact ? "\"genEvent\":null" : " TtGenEvent not available! \n";
   else {
-    log << " TtGenEvent says: ";
-    if( !this->genEvent()->isTtBar() )            log << "Not TtBar";
-    else if( this->genEvent()->isFullHadronic() ) log << "Fully Hadronic TtBar";
-    else if( this->genEvent()->isFullLeptonic() ) log << "Fully Leptonic TtBar";
-    else if( this->genEvent()->isSemiLeptonic() ) {
-      log << "Semi-leptonic TtBar, ";
-      switch( this->genEvent()->semiLeptonicChannel() ) {
-      case WDecay::kElec : log << "Electron"; break;
-      case WDecay::kMuon : log << "Muon"    ; break;
-      case WDecay::kTau  : log << "Tau"     ; break;
-      default            : log << "Unknown" ; break;
-      }
-      log << " Channel";
+    const char* decay   = "";
+    const char* channel = 0;
+    if( !genEvt->isTtBar() )            decay = "Not TtBar";
+    else if( genEvt->isFullHadronic() ) decay = "Fully Hadronic TtBar";
+    else if( genEvt->isFullLeptonic() ) decay = "Fully Leptonic TtBar";
+    else if( genEvt->isSemiLeptonic() ) {
+      decay   = "Semi-leptonic TtBar";
+      channel = lepDecayLabel( genEvt->semiLeptonicChannel() );
+    }
+    if(compact) {
+      dumpFormat(buffer, "\"genEvent\":{\"decay\":\"%s\"", decay);
+      if(channel) dumpFormat(buffer, ",\"channel\":\"%s\"", channel);
+      buffer += "}";
+    }
+    else {
+      dumpFormat(buffer, " TtGenEvent says: %s", decay);
+      if(channel) dumpFormat(buffer, ", %s Channel", channel);
+      buffer += "\n";
     }
-    log << "\n";
   }
 
   // get number of available hypothesis classes
-  log << " Number of available event hypothesis classes: " << this->numberOfAvailableHypoClasses() << " \n";
-
-  // create a legend for the jetLepComb
-  log << " - JetLepComb: ";
-  for(unsigned idx = 0; idx < 5; idx++) {
-    switch(idx) {
-    case TtSemiLepEvtPartons::LightQ    : log << "LightP "; break;
-    case TtSemiLepEvtPartons::LightQBar : log << "LightQ "; break;
-    case TtSemiLepEvtPartons::HadB      : log << " HadB  "; break;
-    case TtSemiLepEvtPartons::LepB      : log << " LepB  "; break;
-    case TtSemiLepEvtPartons::Lepton    : log << "Lepton "; break;
-    }
+  if(compact) dumpFormat(buffer, ",\"numberOfAvailableHypoClasses\":%u,\"hypoClasses\":[", this->numberOfAvailableHypoClasses());
+  else {
+    dumpFormat(buffer, " Number of available event hypothesis classes: %u \n", this->numberOfAvailableHypoClasses());
+    // create a legend for the jetLepComb
+    buffer += " - JetLepComb: LightP LightQ  HadB   LepB  Lepton \n";
   }
-  log << "\n";
 
   // get details from the hypotheses
-  typedef std::map<HypoClassKey, std::vector<HypoCombPair> >::const_iterator EventHypo;
-  for(EventHypo hyp = evtHyp_.begin(); hyp != evtHyp_.end(); ++hyp) {
-    HypoClassKey hypKey = (*hyp).first;
-    // header for each hypothesis
-    log << "-------------------------------------------------- \n";
+  const std::vector<HypoClassId> hypoClassIds = availableHypoClasses();
+  for(std::vector<HypoClassId>::const_iterator hyp = hypoClassIds.begin(); hyp != hypoClassIds.end(); ++hyp) {
+    HypoClassId hypKey = *hyp;
+    const std::vector<reco::CompositeCandidate>& hypos = evtHyp_[hypKey];
+    // header for each hypothesis; classes registered at runtime are labeled by their name
+    const std::string name = hypKey > kHitFit ? TtHypoClassRegistry::name(hypKey) : std::string();
+    const char* label = 0;
+    bool applicable = true;
     switch(hypKey) {
-    case kGeom              : log << " Geom"                                                                ; break;
-    case kWMassMaxSumPt     : log << " WMassMaxSumPt"                                                       ; break;
-    case kMaxSumPtWMass     : log << " MaxSumPtWMass"                                                       ; break;
-    case kGenMatch          : log << " GenMatch"                                                            ; break;
-    case kMVADisc           : log << " MVADisc"                                                             ; break;
-    case kKinFit            : log << " KinFit"                                                              ; break;
-    case kKinSolution       : log << " KinSolution not (yet) applicable to TtSemiLeptonicEvent --> skipping"; continue;
-    case kWMassDeltaTopMass : log << " WMassDeltaTopMass"                                                   ; break;
-    case kHitFit            : log << " HitFit"                                                              ; break;
-    default                 : log << " Unknown TtEvent::HypoClassKey provided --> skipping"                 ; continue;
+    case kGeom              : label = "Geom"                   ; break;
+    case kWMassMaxSumPt     : label = "WMassMaxSumPt"          ; break;
+    case kMaxSumPtWMass     : label = "MaxSumPtWMass"          ; break;
+    case kGenMatch          : label = "GenMatch"               ; break;
+    case kMVADisc           : label = "MVADisc"                ; break;
+    case kKinFit            : label = "KinFit"                 ; break;
+    case kKinSolution       : label = "KinSolution"            ; applicable = false; break;
+    case kWMassDeltaTopMass : label = "WMassDeltaTopMass"      ; break;
+    case kHitFit            : label = "HitFit"                 ; break;
+    default                 : label = name.c_str()             ; break;
     }
-    log << "-Hypothesis: \n";
-    log << " * Number of real neutrino solutions: " << this->numberOfRealNeutrinoSolutions(hypKey) << "\n";
-    log << " * Number of considered jets        : " << this->numberOfConsideredJets(hypKey) << "\n";
-    unsigned nOfHyp = this->numberOfAvailableHypos(hypKey);
-    if(nOfHyp > 1) {
-      log << " * Number of stored jet combinations: " << nOfHyp << "\n";
-      if(verbosity < 10)
-	log << " The following was found to be the best one:\n";
+    if(compact) {
+      dumpFormat(buffer, "%s{\"key\":\"%s\"", hyp==hypoClassIds.begin() ? "" : ",", label);
+      if(!applicable) {
+	buffer += ",\"applicable\":false}";
+	continue;
+      }
+    }
+    else {
+      buffer += "-------------------------------------------------- \n";
+      if(!applicable) {
+	buffer += " KinSolution not (yet) applicable to TtSemiLeptonicEvent --> skipping\n";
+	continue;
+      }
+    }
+    // the per class information is looked up once per class
+    int nRealNuSol = numberOfRealNeutrinoSolutions(hypKey);
+    int nConsJets  = numberOfConsideredJets(hypKey);
+    unsigned nOfHyp = hypos.size();
+    if(compact)
+      dumpFormat(buffer, ",\"numberOfRealNeutrinoSolutions\":%d,\"numberOfConsideredJets\":%d,\"numberOfAvailableHypos\":%u,\"hypos\":[", nRealNuSol, nConsJets, nOfHyp);
+    else {
+      dumpFormat(buffer, " %s-Hypothesis: \n", label);
+      dumpFormat(buffer, " * Number of real neutrino solutions: %d\n", nRealNuSol);
+      dumpFormat(buffer, " * Number of considered jets        : %d\n", nConsJets);
+      if(nOfHyp > 1) {
+	dumpFormat(buffer, " * Number of stored jet combinations: %u\n", nOfHyp);
+	if(verbosity < 10)
+	  buffer += " The following was found to be the best one:\n";
+      }
     }
     // if verbosity level is smaller than 10, never show more than the best jet combination
-    if(verbosity < 10)
+    if(verbosity < 10 && nOfHyp > 1)
       nOfHyp = 1;
     for(unsigned cmb=0; cmb<nOfHyp; cmb++) {
+      const reco::CompositeCandidate& hypo = hypos[cmb];
       // check if hypothesis is valid
-      if( !this->isHypoValid(hypKey, cmb) )
-	log << " * Not valid! \n";
+      if( hypo.roles().empty() ) {
+	if(compact) dumpFormat(buffer, "%s{\"cmb\":%u,\"valid\":false}", cmb==0 ? "" : ",", cmb);
+	else buffer += " * Not valid! \n";
+	continue;
+      }
       // get meta information for valid hypothesis
-      else {
-	// jetLepComb
-	log << " * JetLepComb:";
-	std::vector<int> jets = this->jetLeptonCombination(hypKey, cmb);
-	for(unsigned int iJet = 0; iJet < jets.size(); iJet++) {
-	  log << "   " << jets[iJet] << "   ";
+      if(compact) dumpFormat(buffer, "%s{\"cmb\":%u,\"valid\":true,", cmb==0 ? "" : ",", cmb);
+      else buffer += " * JetLepComb:";
+      dumpJetLeptonCombination(buffer, jetLepComb(hypKey, cmb), "   ", compact);
+      // specialties for some hypotheses
+      switch(hypKey) {
+      case kGenMatch :
+	dumpFormat(buffer, compact ? ",\"genMatchSumDR\":%g,\"genMatchSumPt\":%g" : " * Sum(DeltaR) : %g \n * Sum(DeltaPt): %g \n",
+		   this->genMatchSumDR(cmb), this->genMatchSumPt(cmb)); break;
+      case kMVADisc  :
+	dumpFormat(buffer, compact ? ",\"mvaMethod\":\"%s\",\"mvaDisc\":%g" : " * Method  : %s \n * Discrim.: %g \n",
+		   mvaMethod_.c_str(), this->mvaDisc(cmb)); break;
+      case kKinFit   :
+	dumpFormat(buffer, compact ? ",\"fitChi2\":%g,\"fitProb\":%g" : " * Chi^2      : %g \n * Prob(Chi^2): %g \n",
+		   this->fitChi2(cmb), this->fitProb(cmb)); break;
+      case kHitFit   :
+	dumpFormat(buffer, compact ? ",\"hitFitChi2\":%g,\"hitFitProb\":%g,\"hitFitMT\":%g,\"hitFitSigMT\":%g" : " * Chi^2      : %g \n * Prob(Chi^2): %g \n * Top mass   : %g +/- %g \n",
+		   this->hitFitChi2(cmb), this->hitFitProb(cmb), this->hitFitMT(cmb), this->hitFitSigMT(cmb)); break;
+      default        : break;
+      }
+      // kinematic quantities of particles (if last digit of verbosity level > 1);
+      // the decay tree is walked once instead of once per accessor
+      if(verbosity%10 >= 2) {
+	const reco::Candidate* hadTop = hypo.daughter(TtSemiLepDaughter::HadTop);
+	const reco::Candidate* hadW   = hadTop ? hadTop->daughter(TtSemiLepDaughter::HadW  ) : 0;
+	const reco::Candidate* lepTop = hypo.daughter(TtSemiLepDaughter::LepTop);
+	const reco::Candidate* lepW   = lepTop ? lepTop->daughter(TtSemiLepDaughter::LepW  ) : 0;
+	if(!compact) buffer += " * Candidates (pt; eta; phi; mass):\n";
+	const char* sep = compact ? "," : "";
+	if(verbosity%10 >= 3) {
+	  buffer += sep; dumpParticle(buffer, compact ? "topPair" : "top pair", &hypo, compact);
 	}
-	log << "\n";
-	// specialties for some hypotheses
-	switch(hypKey) {
-	case kGenMatch : log << " * Sum(DeltaR) : " << this->genMatchSumDR(cmb) << " \n"
-			     << " * Sum(DeltaPt): " << this->genMatchSumPt(cmb) << " \n"; break;
-	case kMVADisc  : log << " * Method  : "     << this->mvaMethod()        << " \n"
-			     << " * Discrim.: "     << this->mvaDisc(cmb)       << " \n"; break;
-	case kKinFit   : log << " * Chi^2      : "  << this->fitChi2(cmb)       << " \n"
-			     << " * Prob(Chi^2): "  << this->fitProb(cmb)       << " \n"; break;
-	case kHitFit   : log << " * Chi^2      : "  << this->hitFitChi2(cmb)    << " \n"
-			     << " * Prob(Chi^2): "  << this->hitFitProb(cmb)    << " \n"
-			     << " * Top mass   : "  << this->hitFitMT(cmb)      << " +/- " << this->hitFitSigMT(cmb) << " \n"; break;
-	default        : break;
+	buffer += sep; dumpParticle(buffer, compact ? "hadronicDecayTop" : "hadronic top", hadTop, compact);
+	buffer += sep; dumpParticle(buffer, compact ? "hadronicDecayW"   : "hadronic W  ", hadW  , compact);
+	if(verbosity%10 >= 3) {
+	  buffer += sep; dumpParticle(buffer, compact ? "hadronicDecayB"        : "hadronic b  ", hadTop ? hadTop->daughter(TtSemiLepDaughter::HadB) : 0, compact);
+	  buffer += sep; dumpParticle(buffer, compact ? "hadronicDecayQuark"    : "hadronic p  ", hadW   ? hadW  ->daughter(TtSemiLepDaughter::HadP) : 0, compact);
+	  buffer += sep; dumpParticle(buffer, compact ? "hadronicDecayQuarkBar" : "hadronic q  ", hadW   ? hadW  ->daughter(TtSemiLepDaughter::HadQ) : 0, compact);
 	}
-	// kinematic quantities of particles (if last digit of verbosity level > 1)
-	if(verbosity%10 >= 2) {
-	  log << " * Candidates (pt; eta; phi; mass):\n";
-	  if(verbosity%10 >= 3)
-	    printParticle(log, "top pair", this->topPair(hypKey, cmb));
-	  printParticle(log, "hadronic top", this->hadronicDecayTop(hypKey, cmb));
-	  printParticle(log, "hadronic W  ", this->hadronicDecayW  (hypKey, cmb));
-	  if(verbosity%10 >= 3) {
-	    printParticle(log, "hadronic b  ", this->hadronicDecayB       (hypKey, cmb));
-	    printParticle(log, "hadronic p  ", this->hadronicDecayQuark   (hypKey, cmb));
-	    printParticle(log, "hadronic q  ", this->hadronicDecayQuarkBar(hypKey, cmb));
-	  }
-	  printParticle(log, "leptonic top", this->leptonicDecayTop(hypKey, cmb));
-	  printParticle(log, "leptonic W  ", this->leptonicDecayW  (hypKey, cmb));
-	  if(verbosity%10 >= 3) {
-	    printParticle(log, "leptonic b  ", this->leptonicDecayB(hypKey, cmb));
-	    printParticle(log, "lepton      ", this->singleLepton  (hypKey, cmb));
-	    printParticle(log, "neutrino    ", this->singleNeutrino(hypKey, cmb));
-	  }
+	buffer += sep; dumpParticle(buffer, compact ? "leptonicDecayTop" : "leptonic top", lepTop, compact);
+	buffer += sep; dumpParticle(buffer, compact ? "leptonicDecayW"   : "leptonic W  ", lepW  , compact);
+	if(verbosity%10 >= 3) {
+	  buffer += sep; dumpParticle(buffer, compact ? "leptonicDecayB" : "leptonic b  ", lepTop ? lepTop->daughter(TtSemiLepDaughter::LepB) : 0, compact);
+	  buffer += sep; dumpParticle(buffer, compact ? "singleLepton"   : "lepton      ", lepW   ? lepW  ->daughter(TtSemiLepDaughter::Lep ) : 0, compact);
+	  buffer += sep; dumpParticle(buffer, compact ? "singleNeutrino" : "neutrino    ", lepW   ? lepW  ->daughter(TtSemiLepDaughter::Nu  ) : 0, compact);
 	}
       }
+      if(compact) buffer += "}";
     }
+    if(compact) buffer += "]}";
   }
 
-  log << "++++++++++++++++++++++++++++++++++++++++++++++++++";
+  buffer += compact ? "]}" : "++++++++++++++++++++++++++++++++++++++++++++++++++";
+}
+
+// translate the IDs of all hypothesis classes, including the numbers of neutrino solutions
+void
+TtSemiLeptonicEvent::remapHypoClasses(const std::vector<unsigned int>& translation)
+{
+  // checked before the base class is modified
+  if(!numberOfRealNeutrinoSolutions_.empty())
+    remappedHypoClass(translation, numberOfRealNeutrinoSolutions_.size()-1);
+  TtEvent::remapHypoClasses(translation);
+  remapHypoClassVector(numberOfRealNeutrinoSolutions_, translation, -999);
+}
+
+// the charge of the lepton decides whether the leptonic or the hadronic top is the top quark
+void
+TtSemiLeptonicEvent::systemCandidates(const reco::CompositeCandidate& hypo, const reco::Candidate*& top, const reco::Candidate*& topBar,
+				      const reco::Candidate*& leptonBar, const reco::Candidate*& lepton) const
+{
+  const reco::Candidate* hadTop = hypo.daughter(TtSemiLepDaughter::HadTop);
+  const reco::Candidate* lepTop = hypo.daughter(TtSemiLepDaughter::LepTop);
+  const reco::Candidate* lepW   = lepTop ? lepTop->daughter(TtSemiLepDaughter::LepW) : 0;
+  const reco::Candidate* lep    = lepW   ? lepW  ->daughter(TtSemiLepDaughter::Lep ) : 0;
+  leptonBar = lepton = 0;
+  if( lep && lep->charge()>0 ){
+    top = lepTop; topBar = hadTop; leptonBar = lep;
+  }
+  else{
+    top = hadTop; topBar = lepTop; lepton = lep;
+  }
 }
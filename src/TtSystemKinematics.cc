@@ -0,0 +1,71 @@
+#include "AnalysisDataFormats/TopObjects/interface/TtSystemKinematics.h"
+
+#include <cmath>
+
+namespace {
+  // boost p into the rest frame of 'frame'
+  math::XYZTLorentzVector boostToRestFrame(const math::XYZTLorentzVector& p, const math::XYZTLorentzVector& frame)
+  {
+    double bx = -frame.px()/frame.energy(), by = -frame.py()/frame.energy(), bz = -frame.pz()/frame.energy();
+    double b2 = bx*bx + by*by + bz*bz;
+    if(b2 <= 0. || b2 >= 1.)
+      return p;
+    double gamma = 1./std::sqrt(1.-b2);
+    double bp = bx*p.px() + by*p.py() + bz*p.pz();
+    double gamma2 = (gamma-1.)/b2;
+    return math::XYZTLorentzVector(p.px() + gamma2*bp*bx + gamma*bx*p.energy(),
+				   p.py() + gamma2*bp*by + gamma*by*p.energy(),
+				   p.pz() + gamma2*bp*bz + gamma*bz*p.energy(),
+				   gamma*(p.energy() + bp));
+  }
+
+  // cosine of the angle between the momenta of a and b; -2 if undefined
+  double cosAngle(const math::XYZTLorentzVector& a, const math::XYZTLorentzVector& b)
+  {
+    double norm = a.P()*b.P();
+    return norm > 0. ? (a.px()*b.px() + a.py()*b.py() + a.pz()*b.pz())/norm : -2.;
+  }
+}
+
+void
+TtSystemKinematics::compute(const math::XYZTLorentzVector& top, const math::XYZTLorentzVector& topBar,
+			    const math::XYZTLorentzVector* leptonBar, const math::XYZTLorentzVector* lepton)
+{
+  *this = TtSystemKinematics();
+  valid = true;
+  const math::XYZTLorentzVector ttbar = top+topBar;
+  mass     = ttbar.mass();
+  rapidity = ttbar.Rapidity();
+  pt       = ttbar.pt();
+  // the helicity axis k is the top direction in the ttbar rest frame
+  const math::XYZTLorentzVector topStar = boostToRestFrame(top, ttbar);
+  const double topP = topStar.P();
+  cosThetaStar = topP > 0. ? topStar.pz()/topP : -2.;
+  math::XYZTLorentzVector leptonBarRest, leptonRest;
+  if(leptonBar) {
+    leptonBarRest = boostToRestFrame(boostToRestFrame(*leptonBar, ttbar), topStar);
+    cosThetaLeptonBar = cosAngle(leptonBarRest, topStar);
+  }
+  if(lepton) {
+    // the anti-top moves along -k in the ttbar rest frame
+    const math::XYZTLorentzVector topBarStar = boostToRestFrame(topBar, ttbar);
+    leptonRest = boostToRestFrame(boostToRestFrame(*lepton, ttbar), topBarStar);
+    cosThetaLepton = cosAngle(leptonRest, topBarStar);
+  }
+  if(leptonBar && lepton) {
+    cosPhi = cosAngle(leptonBarRest, leptonRest);
+    deltaPhiLeptons = std::fabs(leptonBar->phi()-lepton->phi());
+    if(deltaPhiLeptons > M_PI)
+      deltaPhiLeptons = 2*M_PI-deltaPhiLeptons;
+  }
+}
+
+void
+TtSystemKinematics::compute(const std::vector<math::XYZTLorentzVector>& tops, const std::vector<math::XYZTLorentzVector>& topBars,
+			    const std::vector<math::XYZTLorentzVector>& leptonBars, const std::vector<math::XYZTLorentzVector>& leptons,
+			    std::vector<TtSystemKinematics>& result)
+{
+  result.resize(tops.size());
+  for(unsigned int i=0; i<tops.size(); ++i)
+    result[i].compute(tops[i], topBars[i], i<leptonBars.size() ? &leptonBars[i] : 0, i<leptons.size() ? &leptons[i] : 0);
+}
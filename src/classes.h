@@ -2,12 +2,19 @@
 #include "AnalysisDataFormats/TopObjects/interface/StGenEvent.h"
 #include "AnalysisDataFormats/TopObjects/interface/TopGenEvent.h"
 #include "AnalysisDataFormats/TopObjects/interface/TtEvent.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtJetLepComb.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtHypoClassTable.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtHypoScoreColumns.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtEventSummary.h"
+#include "AnalysisDataFormats/TopObjects/interface/TtEventArrays.h"
 #include "AnalysisDataFormats/TopObjects/interface/TtFullLeptonicEvent.h"
 #include "AnalysisDataFormats/TopObjects/interface/TtSemiLeptonicEvent.h"
 #include "AnalysisDataFormats/TopObjects/interface/TtFullHadronicEvent.h"
 #include "AnalysisDataFormats/TopObjects/interface/CATopJetTagInfo.h"
+#include "AnalysisDataFormats/TopObjects/interface/CATopJetFlatTagInfoCollection.h"
 
 #include "AnalysisDataFormats/TopObjects/interface/StEvtSolution.h"
+#include "AnalysisDataFormats/TopObjects/interface/TopScanCurve.h"
 #include "AnalysisDataFormats/TopObjects/interface/TtDilepEvtSolution.h"
 #include "AnalysisDataFormats/TopObjects/interface/TtHadEvtSolution.h"
 #include "AnalysisDataFormats/TopObjects/interface/TtSemiEvtSolution.h"
@@ -46,10 +53,20 @@ namespace {
 
     std::map<TtEvent::HypoClassKey, int> m_key_int;
     std::map<TtEvent::HypoClassKey, std::vector<std::pair<reco::CompositeCandidate, std::vector<int> > > > m_key_v_p_compcand_vint;
+    TtJetLepCombBuffer jetlepcombs;
+    std::vector<std::vector<reco::CompositeCandidate> > v_v_compcand;
+    std::vector<TtJetLepCombBuffer> v_jetlepcombs;
+    TtHypoClassTable hypoclasstable;
+    edm::Wrapper<TtHypoClassTable> w_hypoclasstable;
+    TtHypoScoreColumns hyposcorecolumns;
+    TtEventSummary ttevtsummary;
+    edm::Wrapper<TtEventSummary> w_ttevtsummary;
+    std::vector<const TtEvent*> v_p_ttevent;
 
     TtDilepEvtSolution ttdilep;
     TtSemiEvtSolution ttsemi;
     TtHadEvtSolution tthad;
+    TopScanCurve scancurve;
     StEvtSolution st;
     std::vector<TtDilepEvtSolution> v_ttdilep;
     std::vector<TtSemiEvtSolution> v_ttsemi;
@@ -71,5 +88,8 @@ namespace {
     edm::Wrapper<reco::CATopJetTagInfoCollection>                       catopjet_wc;
     edm::reftobase::Holder<reco::BaseTagInfo, reco::CATopJetTagInfoRef> rb_catopjet;
     edm::reftobase::RefHolder<reco::CATopJetTagInfoRef>                 rbh_catopjet; 
+
+    reco::CATopJetFlatTagInfoCollection                                 catopjet_fc;
+    edm::Wrapper<reco::CATopJetFlatTagInfoCollection>                   catopjet_wfc;
   };
 }